@@ -0,0 +1,330 @@
+// 压测客户端：对比不同 io_context 后端（epoll / io_uring）下服务器的吞吐与延迟
+// 用法：AsioBench <host> <port> <echo|relay|upload> [connections] [seconds] [payload] [pipeline] [threads]
+//   echo  ：HelloService 回显，每个连接保持 pipeline 个在途请求
+//   relay ：CommunicationService 转发，连接两两配对注册后互相发送，统计发送确认延迟与转发到达数
+//   upload：同 relay，但每个请求为 UPLOAD_CHUNKS 个分片的流式转发（服务端逐片按序转发，最后一片后回应）
+// 客户端与服务器使用同一编译选项构建，即可在相同负载下对比两种后端
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "../../core/common/Const.h"
+#include "../../core/protocol/MessageHeader.h"
+#include "../../infra/util/json.hpp"
+
+namespace asio = boost::asio;
+using asio::ip::tcp;
+using Clock = std::chrono::steady_clock;
+
+// 流式转发模式下每个请求的分片数
+constexpr std::size_t UPLOAD_CHUNKS = 4;
+
+// 压测参数
+struct BenchOptions
+{
+    std::string host = "127.0.0.1";
+    std::string port = "19998";
+    std::string mode = "echo";
+    std::size_t connections = 100;
+    std::size_t seconds = 10;
+    std::size_t payload = 64;
+    std::size_t pipeline = 8;
+    std::size_t threads = 1;
+};
+
+// 单个连接的统计（只在该连接的 strand 中访问）
+struct ConnStats
+{
+    uint64_t responses = 0;             // 收到的响应数
+    uint64_t relayed = 0;               // 收到的转发消息数
+    uint64_t errors = 0;                // 出错的连接数
+    std::vector<uint32_t> latenciesUs;  // 请求延迟（微秒）
+};
+
+// 压测连接
+class BenchConnection : public std::enable_shared_from_this<BenchConnection>
+{
+public:
+    BenchConnection(asio::io_context &ioc, const BenchOptions &options, std::size_t index, Clock::time_point deadline)
+        : _strand(asio::make_strand(ioc)),
+          _socket(_strand),
+          _options(options),
+          _index(index),
+          _deadline(deadline),
+          _sendTimes(std::max<std::size_t>(options.pipeline, 1))
+    {
+    }
+
+    // 建立连接并开始压测
+    void Start(const tcp::resolver::results_type &endpoints)
+    {
+        asio::co_spawn(this->_strand, Run(shared_from_this(), endpoints), asio::detached);
+    }
+
+    const ConnStats &GetStats() const { return this->_stats; }
+
+private:
+    // 编码一帧（JSON 文本消息体）
+    static std::string EncodeFrame(uint16_t serviceId, uint16_t cmdId, uint32_t seq, const std::string &body, bool more = false)
+    {
+        MessageHeader header{};
+        header.magic = 0x55AA;
+        header.version = 1;
+        header.SetFlag(HEADER_FLAG_MORE, more);
+        header.serviceId = serviceId;
+        header.cmdId = cmdId;
+        header.length = static_cast<uint32_t>(body.size());
+        header.seq = seq;
+        header.ToNetwork();
+
+        std::string frame(sizeof(MessageHeader) + body.size(), '\0');
+        std::memcpy(frame.data(), &header, sizeof(MessageHeader));
+        std::memcpy(frame.data() + sizeof(MessageHeader), body.data(), body.size());
+        return frame;
+    }
+
+    // 读取一帧，返回帧头（本地字节序），消息体写入 body
+    asio::awaitable<MessageHeader> ReadFrame(std::string &body)
+    {
+        MessageHeader header{};
+        co_await asio::async_read(this->_socket, asio::buffer(&header, sizeof(header)), asio::use_awaitable);
+        header.ToHost();
+        body.resize(header.length);
+        if (header.length > 0)
+            co_await asio::async_read(this->_socket, asio::buffer(body.data(), body.size()), asio::use_awaitable);
+        co_return header;
+    }
+
+    // 构造一个请求
+    std::string MakeRequest(uint32_t seq) const
+    {
+        if (this->_options.mode == "upload")
+        {
+            // 同一 seq 的多个分片连续发送，除最后一片外均带 MORE 标志
+            auto peer = this->_index ^ 1;
+            std::string frames;
+            for (std::size_t i = 0; i < UPLOAD_CHUNKS; i++)
+            {
+                nlohmann::json body = {{"target", {{"client", "bench-" + std::to_string(peer)}, {"data", this->_message}}}};
+                frames += EncodeFrame(SERVICE_COMMUNICATION, COMMUINICATION_UPLOAD, seq, body.dump(), i + 1 < UPLOAD_CHUNKS);
+            }
+            return frames;
+        }
+        if (this->_options.mode == "relay")
+        {
+            // 两两配对：偶数号发给下一个，奇数号发给上一个
+            auto peer = this->_index ^ 1;
+            nlohmann::json body = {{"target", {{"client", "bench-" + std::to_string(peer)}, {"message", this->_message}}}};
+            return EncodeFrame(SERVICE_COMMUNICATION, COMMUINICATION_SEND, seq, body.dump());
+        }
+        return EncodeFrame(SERVICE_HELLO, HELLO_CMD_TEST, seq, this->_message);
+    }
+
+    // 发送一个请求并记录发送时间
+    asio::awaitable<void> SendRequest()
+    {
+        auto seq = ++this->_seq;
+        this->_sendTimes[seq % this->_sendTimes.size()] = Clock::now();
+        auto frame = MakeRequest(seq);
+        co_await asio::async_write(this->_socket, asio::buffer(frame), asio::use_awaitable);
+    }
+
+    static asio::awaitable<void> Run(std::shared_ptr<BenchConnection> self, tcp::resolver::results_type endpoints)
+    {
+        try
+        {
+            co_await asio::async_connect(self->_socket, endpoints, asio::use_awaitable);
+            self->_socket.set_option(tcp::no_delay(true));
+            self->_message.assign(self->_options.payload, 'x');
+
+            std::string body;
+            // 转发模式：先注册名称
+            if (self->_options.mode != "echo")
+            {
+                nlohmann::json reg = {{"target", {{"name", "bench-" + std::to_string(self->_index)}}}};
+                auto frame = EncodeFrame(SERVICE_COMMUNICATION, COMMUINICATION_REGISTER, 0, reg.dump());
+                co_await asio::async_write(self->_socket, asio::buffer(frame), asio::use_awaitable);
+                co_await self->ReadFrame(body);
+                // 等待配对方注册完成
+                asio::steady_timer timer(self->_strand, std::chrono::milliseconds(500));
+                co_await timer.async_wait(asio::use_awaitable);
+            }
+
+            // 填满在途窗口
+            for (std::size_t i = 0; i < self->_options.pipeline; i++)
+            {
+                co_await self->SendRequest();
+            }
+
+            // 每收到一个响应补发一个请求，直至压测结束
+            std::size_t inflight = self->_options.pipeline;
+            while (inflight > 0)
+            {
+                auto header = co_await self->ReadFrame(body);
+
+                // 其他连接转发来的消息（流式转发的分片以 seq 0 转发，请求的 seq 从 1 开始）
+                if (header.cmdId == COMMUINICATION_RECV || (header.cmdId == COMMUINICATION_UPLOAD && header.seq == 0))
+                {
+                    ++self->_stats.relayed;
+                    continue;
+                }
+
+                auto now = Clock::now();
+                auto sendTime = self->_sendTimes[header.seq % self->_sendTimes.size()];
+                self->_stats.latenciesUs.push_back(static_cast<uint32_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(now - sendTime).count()));
+                ++self->_stats.responses;
+                --inflight;
+
+                if (now < self->_deadline)
+                {
+                    co_await self->SendRequest();
+                    ++inflight;
+                }
+            }
+
+            // 转发模式：等待配对方的在途消息送达后再断开
+            if (self->_options.mode != "echo")
+            {
+                asio::steady_timer timer(self->_strand, std::chrono::milliseconds(200));
+                co_await timer.async_wait(asio::use_awaitable);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            ++self->_stats.errors;
+            std::cerr << "Connection " << self->_index << ": " << e.what() << std::endl;
+        }
+
+        boost::system::error_code ec;
+        self->_socket.close(ec);
+    }
+
+    asio::strand<asio::io_context::executor_type> _strand;
+    tcp::socket _socket;
+    const BenchOptions &_options;
+    std::size_t _index;
+    Clock::time_point _deadline;
+    // 在途请求的发送时间，按 seq 取模（在途请求数不超过窗口，不会冲突）
+    std::vector<Clock::time_point> _sendTimes;
+    uint32_t _seq = 0;
+    std::string _message;
+    ConnStats _stats;
+};
+
+// 后端名称
+static const char *BackendName()
+{
+#if defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_DISABLE_EPOLL)
+    return "io_uring";
+#elif defined(BOOST_ASIO_HAS_IO_URING)
+    return "epoll + io_uring (files)";
+#else
+    return "default (epoll/kqueue/iocp)";
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 4)
+    {
+        std::cerr << "Usage: " << argv[0] << " <host> <port> <echo|relay|upload> [connections] [seconds] [payload] [pipeline] [threads]" << std::endl;
+        return 1;
+    }
+
+    BenchOptions options;
+    options.host = argv[1];
+    options.port = argv[2];
+    options.mode = argv[3];
+    if (argc > 4)
+        options.connections = std::stoul(argv[4]);
+    if (argc > 5)
+        options.seconds = std::stoul(argv[5]);
+    if (argc > 6)
+        options.payload = std::stoul(argv[6]);
+    if (argc > 7)
+        options.pipeline = std::max<std::size_t>(std::stoul(argv[7]), 1);
+    if (argc > 8)
+        options.threads = std::max<std::size_t>(std::stoul(argv[8]), 1);
+
+    if (options.mode != "echo" && options.mode != "relay" && options.mode != "upload")
+    {
+        std::cerr << "Unknown mode: " << options.mode << std::endl;
+        return 1;
+    }
+    // 转发模式需要成对的连接
+    if (options.mode != "echo" && options.connections % 2 != 0)
+        ++options.connections;
+
+    std::cout << "Backend: " << BackendName() << ", mode: " << options.mode
+              << ", connections: " << options.connections << ", seconds: " << options.seconds
+              << ", payload: " << options.payload << ", pipeline: " << options.pipeline
+              << ", threads: " << options.threads << std::endl;
+
+    asio::io_context ioc;
+    tcp::resolver resolver(ioc);
+    auto endpoints = resolver.resolve(options.host, options.port);
+
+    auto start = Clock::now();
+    auto deadline = start + std::chrono::seconds(options.seconds);
+
+    std::vector<std::shared_ptr<BenchConnection>> connections;
+    connections.reserve(options.connections);
+    for (std::size_t i = 0; i < options.connections; i++)
+    {
+        connections.push_back(std::make_shared<BenchConnection>(ioc, options, i, deadline));
+        connections.back()->Start(endpoints);
+    }
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < options.threads; i++)
+    {
+        threads.emplace_back([&ioc]()
+                             { ioc.run(); });
+    }
+    ioc.run();
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // 汇总
+    ConnStats total;
+    for (auto &conn : connections)
+    {
+        auto &stats = conn->GetStats();
+        total.responses += stats.responses;
+        total.relayed += stats.relayed;
+        total.errors += stats.errors;
+        total.latenciesUs.insert(total.latenciesUs.end(), stats.latenciesUs.begin(), stats.latenciesUs.end());
+    }
+    std::sort(total.latenciesUs.begin(), total.latenciesUs.end());
+    auto percentile = [&total](double p) -> uint32_t
+    {
+        if (total.latenciesUs.empty())
+            return 0;
+        auto index = static_cast<std::size_t>(p * (total.latenciesUs.size() - 1));
+        return total.latenciesUs[index];
+    };
+
+    std::cout << "Responses: " << total.responses
+              << " (" << static_cast<uint64_t>(total.responses / elapsed) << "/s)";
+    if (options.mode != "echo")
+        std::cout << ", relayed: " << total.relayed << " (" << static_cast<uint64_t>(total.relayed / elapsed) << "/s)";
+    std::cout << ", errors: " << total.errors << std::endl;
+    std::cout << "Latency us: p50=" << percentile(0.50) << ", p90=" << percentile(0.90)
+              << ", p99=" << percentile(0.99) << ", max=" << percentile(1.0) << std::endl;
+
+    return total.errors == 0 ? 0 : 2;
+}
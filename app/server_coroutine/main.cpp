@@ -6,9 +6,11 @@
 #include "../../config/ConfigManager.h"
 
 #include "../../core/server/CServer.h"
+#include "../../core/session/CSession.h"
 #include "../../core/session/AsioIOServicePool.h"
 
 #include "../../infra/log/Logger.h"
+#include "../../infra/metrics/Metrics.h"
 
 #include "../../services/IService.h"
 #include "../../services/ServiceManager.h"
@@ -52,6 +54,22 @@ uint16_t GetPortFromConfig()
     return port;
 }
 
+// 定期输出运行指标
+void StartMetricsReport(boost::asio::steady_timer &timer, uint16_t interval)
+{
+    // 间隔为 0 表示不输出
+    if (interval == 0)
+        return;
+
+    timer.expires_after(std::chrono::seconds(interval));
+    timer.async_wait([&timer, interval](const boost::system::error_code &ec)
+                     {
+                         if (ec)
+                             return;
+                         Metrics::GetInstance().LogSnapshot();
+                         StartMetricsReport(timer, interval); });
+}
+
 // 跨平台获取相对路径对应的绝对路径
 std::string GetAbsolutePath(const char *exePath, const std::string &relativePath)
 {
@@ -99,6 +117,8 @@ int main(int argc, char *argv[])
         DBExecutor::GetInstance().InitializeFromConfig("../config/database.json");
         // 注册服务
         RegisterServices();
+        // 冻结服务表，此后分发查找不再加锁
+        ServiceManager::GetInstance().Freeze();
 
         // 端口
         const uint16_t port = GetPortFromConfig();
@@ -106,17 +126,27 @@ int main(int argc, char *argv[])
         auto &pool = AsioIOServicePool::GetInstance();
         // 获取连接的上下文
         boost::asio::io_context ioc;
+        // 声明服务
+        CServer server(ioc, port);
         // 添加信号量，用于退出
         boost::asio::signal_set signals(ioc, SIGINT, SIGTERM);
         // 异步等待
         signals.async_wait([&](auto, auto)
                            {
+                                server.Stop();
+                                // 关闭所有连接：挂起的读取随之结束，否则线程池的 io_context 无法退出
+                                LOG_INFO << "Close " << server.GetSessionCount() << " sessions" << std::endl;
+                                server.ForEachSession([](const std::shared_ptr<CSession> &session)
+                                                      { session->Close(); });
                                 ioc.stop();
                                 pool.Stop(); });
-        // 声明服务
-        CServer server(ioc, port);
+        // 定期输出运行指标
+        boost::asio::steady_timer metricsTimer(ioc);
+        StartMetricsReport(metricsTimer, ConfigManager::GetInstance().GetMetricsInterval());
         // 启动服务
         ioc.run();
+        // 退出前输出最终指标
+        Metrics::GetInstance().LogSnapshot();
     }
     catch (const std::exception &e)
     {
@@ -1,5 +1,8 @@
 #include "ConfigManager.h"
 #include "ConfigReader.h"
+#include "../infra/log/Logger.h"
+
+#include <algorithm>
 
 ConfigManager &ConfigManager::GetInstance()
 {
@@ -14,7 +17,111 @@ void ConfigManager::LoadConfig(const std::string &configPath)
     // 获取配置文件中的配置项
     this->_port = configReader->GetInt("port").value_or(19998);
     this->_threadPoolSize = configReader->GetInt("thread_pool_size").value_or(2);
+    this->_logicWorkers = std::max(configReader->GetInt("logic_workers").value_or(2), 1);
+    this->_computeThreads = std::max(configReader->GetInt("compute_threads").value_or(2), 1);
+    // AsyncSession 分发方式：direct（直接在 io_context 上执行）或 logic（全部经由 LogicSystem）
+    this->_asyncDirectDispatch = configReader->GetString("async_dispatch").value_or("logic") == "direct";
     this->_logPath = configReader->GetString("log_path").value_or("./server.log");
+    this->_metricsInterval = configReader->GetInt("metrics_interval").value_or(60);
+    // 帧与消息的长度上限：至少为 1，单帧不超过 64MB 且不超过消息上限（为 0 时分片发送无法推进）
+    this->_maxMessageSize = std::max(configReader->GetInt("max_message_size").value_or(16 * 1024 * 1024), 1);
+    auto maxFrameSize = std::max(configReader->GetInt("max_frame_size").value_or(1024 * 1024), 1);
+    this->_maxFrameSize = static_cast<uint32_t>(std::min<std::size_t>({static_cast<std::size_t>(maxFrameSize), this->_maxMessageSize, 64 * 1024 * 1024}));
+
+    // 流水线：窗口大小及各服务的分发模式（concurrent / ordered / serial）
+    this->_pipelineWindow = std::max(configReader->GetInt("pipeline/window").value_or(16), 1);
+    this->_dispatchModes.clear();
+    if (configReader->HasKey("pipeline/services"))
+    {
+        auto &services = configReader->GetRawConfig()["pipeline"]["services"];
+        for (auto &[serviceId, mode] : services.items())
+        {
+            auto name = mode.get<std::string>();
+            DISPATCH_MODE value = DISPATCH_CONCURRENT;
+            if (name == "ordered")
+                value = DISPATCH_ORDERED;
+            else if (name == "serial")
+                value = DISPATCH_SERIAL;
+            this->_dispatchModes[static_cast<uint16_t>(std::stoi(serviceId))] = value;
+        }
+    }
+
+    // 发送积压水位：低水位不高于高水位，硬上限不低于高水位
+    this->_sendHighWatermark = configReader->GetInt("send_watermark/high").value_or(1024 * 1024);
+    this->_sendLowWatermark = std::min<std::size_t>(configReader->GetInt("send_watermark/low").value_or(256 * 1024), this->_sendHighWatermark);
+    this->_sendHardLimit = std::max<std::size_t>(configReader->GetInt("send_watermark/hard").value_or(16 * 1024 * 1024), this->_sendHighWatermark);
+
+    // 监听模式：默认单个监听器，开启后线程池中每个上下文各一个 SO_REUSEPORT 监听器
+    this->_reusePort = configReader->GetBool("reuse_port").value_or(false);
+
+    // 绑核与 NUMA：线程绑定的 CPU 列表，新连接引导至哪块网卡所在的节点
+    this->_affinityCpus = configReader->GetString("affinity/cpus").value_or("");
+    this->_affinityNic = configReader->GetString("affinity/nic").value_or("");
+
+    // 套接字调优：未配置的项使用 SocketProfile 的默认值
+    SocketProfile profile;
+    this->_socketProfile.noDelay = configReader->GetBool("socket/no_delay").value_or(profile.noDelay);
+    this->_socketProfile.keepAlive = configReader->GetBool("socket/keep_alive").value_or(profile.keepAlive);
+    this->_socketProfile.keepAliveIdle = configReader->GetInt("socket/keep_alive_idle_sec").value_or(profile.keepAliveIdle);
+    this->_socketProfile.keepAliveInterval = configReader->GetInt("socket/keep_alive_interval_sec").value_or(profile.keepAliveInterval);
+    this->_socketProfile.keepAliveCount = configReader->GetInt("socket/keep_alive_count").value_or(profile.keepAliveCount);
+    this->_socketProfile.recvBuffer = std::max(configReader->GetInt("socket/recv_buffer").value_or(profile.recvBuffer), 0);
+    this->_socketProfile.sendBuffer = std::max(configReader->GetInt("socket/send_buffer").value_or(profile.sendBuffer), 0);
+    this->_socketProfile.notSentLowat = std::max(configReader->GetInt("socket/notsent_lowat").value_or(profile.notSentLowat), 0);
+    this->_socketProfile.backlog = std::max(configReader->GetInt("socket/backlog").value_or(profile.backlog), 0);
+
+    // 空闲检测：超时时间与时间轮粒度
+    this->_idleTimeout = std::max(configReader->GetInt("idle_timeout_sec").value_or(60), 0);
+    this->_idleTick = std::max(configReader->GetInt("idle_tick_ms").value_or(1000), 1);
+
+    // 公平调度：每个 io_context 同时执行的回调上限，超出时按客户端权重轮转分配
+    this->_schedulerMaxRunning = std::max(configReader->GetInt("scheduler/max_running").value_or(0), 0);
+    this->_clientWeights.clear();
+    if (configReader->HasKey("scheduler/weights"))
+    {
+        auto &weights = configReader->GetRawConfig()["scheduler"]["weights"];
+        for (auto &[name, weight] : weights.items())
+        {
+            // 权重须为正整数，否则跳过（按默认权重 1 调度）
+            if (!weight.is_number_integer() || weight.get<int64_t>() <= 0 || weight.get<int64_t>() > UINT32_MAX)
+            {
+                LOG_WARN << "scheduler/weights: skip invalid weight for \"" << name << "\": " << weight.dump() << std::endl;
+                continue;
+            }
+            this->_clientWeights[name] = static_cast<uint32_t>(weight.get<int64_t>());
+        }
+    }
+
+    // 消息优先级："serviceId" 作用于整个服务，"serviceId:cmdId" 作用于单个命令（优先于整个服务）
+    // 未配置时心跳服务为控制消息
+    this->_priorities.clear();
+    if (configReader->HasKey("priority"))
+    {
+        auto &priorities = configReader->GetRawConfig()["priority"];
+        for (auto &[key, value] : priorities.items())
+        {
+            auto pos = key.find(':');
+            auto serviceId = static_cast<uint16_t>(std::stoi(key.substr(0, pos)));
+            auto cmdId = pos == std::string::npos ? PRIORITY_ANY_CMD : static_cast<uint16_t>(std::stoi(key.substr(pos + 1)));
+            this->_priorities[PriorityKey(serviceId, cmdId)] = value.get<std::string>() == "control" ? PRIORITY_CONTROL : PRIORITY_BULK;
+        }
+    }
+    else
+    {
+        this->_priorities[PriorityKey(SERVICE_HEART, PRIORITY_ANY_CMD)] = PRIORITY_CONTROL;
+    }
+
+    // 压缩策略：仅对配置了阈值的服务、且响应体超过阈值时压缩
+    this->_compressionLevel = configReader->GetInt("compression/level").value_or(1);
+    this->_compressionThresholds.clear();
+    if (configReader->GetBool("compression/enable").value_or(false) && configReader->HasKey("compression/services"))
+    {
+        auto &services = configReader->GetRawConfig()["compression"]["services"];
+        for (auto &[serviceId, threshold] : services.items())
+        {
+            this->_compressionThresholds[static_cast<uint16_t>(std::stoi(serviceId))] = threshold.get<uint32_t>();
+        }
+    }
     // 关闭配置文件读取器
     configReader.reset();
 }
\ No newline at end of file
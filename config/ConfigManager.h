@@ -1,8 +1,14 @@
 #ifndef CONFIGMANAGER_H
 #define CONFIGMANAGER_H
 
+#include <cstddef>
 #include <cstdint>
 #include <string>
+#include <optional>
+#include <unordered_map>
+
+#include "../core/common/Const.h"
+#include "../core/server/SocketProfile.h"
 
 // 配置管理类，用于缓存服务器配置信息，单例模式
 
@@ -23,8 +29,80 @@ public:
     uint16_t GetPort() const { return this->_port; }
     // 获取线程池大小
     uint16_t GetThreadPoolSize() const { return this->_threadPoolSize; }
+    // 获取 LogicSystem 工作线程数量
+    uint16_t GetLogicWorkers() const { return this->_logicWorkers; }
+    // 获取计算线程池线程数量
+    uint16_t GetComputeThreads() const { return this->_computeThreads; }
+    // AsyncSession 是否直接在会话的 io_context 上分发（阻塞命令仍交给 LogicSystem）
+    bool IsAsyncDirectDispatch() const { return this->_asyncDirectDispatch; }
     // 获取日志路径
     const std::string &GetLogPath() const { return this->_logPath; }
+    // 获取运行指标输出间隔（秒，0 表示不输出）
+    uint16_t GetMetricsInterval() const { return this->_metricsInterval; }
+    // 获取单帧消息体的最大长度（字节），超出即断开连接，更大的消息需分片传输
+    uint32_t GetMaxFrameSize() const { return this->_maxFrameSize; }
+    // 获取每个连接分片重组的预算（字节）
+    std::size_t GetMaxMessageSize() const { return this->_maxMessageSize; }
+    // 获取每个连接的在途请求窗口大小（超出后暂停读取）
+    std::size_t GetPipelineWindow() const { return this->_pipelineWindow; }
+    // 获取某服务在连接内的分发模式，未配置时为并发处理
+    DISPATCH_MODE GetDispatchMode(uint16_t serviceId) const
+    {
+        auto it = this->_dispatchModes.find(serviceId);
+        if (it == this->_dispatchModes.end())
+            return DISPATCH_CONCURRENT;
+        return it->second;
+    }
+    // 获取发送积压的高水位（字节），超过后暂停读取该连接
+    std::size_t GetSendHighWatermark() const { return this->_sendHighWatermark; }
+    // 获取发送积压的低水位（字节），低于后恢复读取
+    std::size_t GetSendLowWatermark() const { return this->_sendLowWatermark; }
+    // 获取发送积压的硬上限（字节），已有积压超过后再入队时断开连接
+    std::size_t GetSendHardLimit() const { return this->_sendHardLimit; }
+    // 是否为线程池中每个上下文各启动一个 SO_REUSEPORT 监听器
+    bool IsReusePortEnabled() const { return this->_reusePort; }
+    // 获取 io_context 线程绑定的 CPU 列表（如 "0-3,8"，空表示不绑定）
+    const std::string &GetAffinityCpus() const { return this->_affinityCpus; }
+    // 获取引导新连接的网卡名称（新连接分配至网卡所在 NUMA 节点的上下文，空表示不引导）
+    const std::string &GetAffinityNic() const { return this->_affinityNic; }
+    // 获取套接字调优参数
+    const SocketProfile &GetSocketProfile() const { return this->_socketProfile; }
+    // 获取空闲超时（秒，0 表示不检测）
+    uint32_t GetIdleTimeout() const { return this->_idleTimeout; }
+    // 获取空闲检测粒度（毫秒）
+    uint32_t GetIdleTick() const { return this->_idleTick; }
+    // 获取每个 io_context 同时执行的回调上限（0 表示不调度）
+    std::size_t GetSchedulerMaxRunning() const { return this->_schedulerMaxRunning; }
+    // 获取客户端的调度权重，未配置时为 1
+    uint32_t GetClientWeight(const std::string &name) const
+    {
+        auto it = this->_clientWeights.find(name);
+        if (it == this->_clientWeights.end())
+            return 1;
+        return it->second;
+    }
+    // 获取消息的优先级：先按 (serviceId, cmdId) 查找，再按整个服务查找，未配置时为普通消息
+    MSG_PRIORITY GetPriority(uint16_t serviceId, uint16_t cmdId) const
+    {
+        if (this->_priorities.empty())
+            return PRIORITY_BULK;
+        auto it = this->_priorities.find(PriorityKey(serviceId, cmdId));
+        if (it == this->_priorities.end())
+            it = this->_priorities.find(PriorityKey(serviceId, PRIORITY_ANY_CMD));
+        if (it == this->_priorities.end())
+            return PRIORITY_BULK;
+        return it->second;
+    }
+    // 获取压缩等级（zlib 1~9）
+    int GetCompressionLevel() const { return this->_compressionLevel; }
+    // 获取某服务响应的压缩阈值（字节），未配置时返回空，表示该服务不压缩
+    std::optional<uint32_t> GetCompressionThreshold(uint16_t serviceId) const
+    {
+        auto it = this->_compressionThresholds.find(serviceId);
+        if (it == this->_compressionThresholds.end())
+            return std::nullopt;
+        return it->second;
+    }
 
     // 获取单例对象
     static ConfigManager &GetInstance();
@@ -36,13 +114,57 @@ private:
     // 私有化构造函数，防止外部创建对象
     ConfigManager() = default;
 
+    // 优先级配置中表示整个服务的命令 ID（命令 ID 不会超过 IService::MAX_CMD_ID）
+    static constexpr uint16_t PRIORITY_ANY_CMD = 0xFFFF;
+    // 优先级表的键 serviceId << 16 | cmdId
+    static uint32_t PriorityKey(uint16_t serviceId, uint16_t cmdId) { return (static_cast<uint32_t>(serviceId) << 16) | cmdId; }
+
     // 配置信息，应与 server.json 中的字段对应
     // 服务器端口号
     uint16_t _port;
     // 线程池大小
     uint16_t _threadPoolSize;
+    // LogicSystem 工作线程数量
+    uint16_t _logicWorkers;
+    // 计算线程池线程数量
+    uint16_t _computeThreads;
+    // AsyncSession 直接分发
+    bool _asyncDirectDispatch;
     // 日志路径
     std::string _logPath;
+    // 运行指标输出间隔（秒）
+    uint16_t _metricsInterval;
+    // 单帧消息体的最大长度
+    uint32_t _maxFrameSize;
+    // 分片重组预算
+    std::size_t _maxMessageSize;
+    // 在途请求窗口大小
+    std::size_t _pipelineWindow;
+    // 各服务的分发模式 serviceId -> 模式
+    std::unordered_map<uint16_t, DISPATCH_MODE> _dispatchModes;
+    // 发送积压的高水位、低水位与硬上限
+    std::size_t _sendHighWatermark;
+    std::size_t _sendLowWatermark;
+    std::size_t _sendHardLimit;
+    // 是否启用 SO_REUSEPORT 多监听器
+    bool _reusePort;
+    // 绑核 CPU 列表与引导网卡
+    std::string _affinityCpus;
+    std::string _affinityNic;
+    // 套接字调优参数
+    SocketProfile _socketProfile;
+    // 空闲超时（秒）与检测粒度（毫秒）
+    uint32_t _idleTimeout;
+    uint32_t _idleTick;
+    // 调度：同时执行上限及各客户端权重 名称 -> 权重
+    std::size_t _schedulerMaxRunning;
+    std::unordered_map<std::string, uint32_t> _clientWeights;
+    // 消息优先级 serviceId << 16 | cmdId -> 优先级
+    std::unordered_map<uint32_t, MSG_PRIORITY> _priorities;
+    // 压缩等级
+    int _compressionLevel;
+    // 各服务的压缩阈值 serviceId -> 字节数
+    std::unordered_map<uint16_t, uint32_t> _compressionThresholds;
 };
 
 #endif
\ No newline at end of file
@@ -5,8 +5,12 @@
 #include <string>
 #include <cstddef>
 
-const std::size_t MAX_RECVQUE_LEN = 10000; // 最大接收队列长度
-const std::size_t MAX_SENDQUE_LEN = 1000;  // 最大发送队列长度
+const std::size_t MAX_RECVQUE_LEN = 10000;       // 最大接收队列长度
+const std::size_t MAX_SENDQUE_LEN = 1024;        // 跨线程发送队列容量（帧数）
+const std::size_t RECV_BUFFER_SIZE = 64 * 1024;  // 会话接收缓冲区大小
+const std::size_t MAX_WRITE_FRAMES = 64;         // 单次合并写的最大帧数
+const std::size_t MAX_WRITE_BYTES = 256 * 1024;  // 单次合并写的最大字节数
+const std::size_t MAX_CONTROL_INFLIGHT = 8;      // 每个会话同时执行的控制消息上限（超出部分按普通消息分发）
 
 // ASIO类型枚举
 enum ASIO_TYPE
@@ -24,6 +28,21 @@ enum SERVICE_TYPE
     SERVICE_COMMUNICATION = 3, // 通信服务
 };
 
+// 连接内的服务分发模式枚举
+enum DISPATCH_MODE
+{
+    DISPATCH_CONCURRENT = 0, // 并发处理，响应按完成顺序发送（可能乱序）
+    DISPATCH_ORDERED = 1,    // 并发处理，响应按请求到达顺序发送
+    DISPATCH_SERIAL = 2,     // 逐个处理（同一服务），响应按请求到达顺序发送
+};
+
+// 消息优先级枚举（按 serviceId / cmdId 配置）
+enum MSG_PRIORITY
+{
+    PRIORITY_BULK = 0,    // 普通消息
+    PRIORITY_CONTROL = 1, // 控制消息（如心跳）：入站不排队等待调度，出站插队至普通消息之前发送
+};
+
 // 心跳检测服务命令枚举
 enum HEART_CMD
 {
@@ -47,11 +66,13 @@ enum DB_CMD
 // 通信服务命令枚举
 enum COMMUNICATION_CMD
 {
-    COMMUINICATION_REGISTER = 1, // 创建连接
-    COMMUINICATION_CLOSE = 2,    // 关闭连接
-    COMMUINICATION_SEND = 3,     // 发送数据
-    COMMUINICATION_RECV = 4,     // 接收数据
-    COMMUINICATION_SHOW = 5,     // 显示连接信息
+    COMMUINICATION_REGISTER = 1,  // 创建连接
+    COMMUINICATION_CLOSE = 2,     // 关闭连接
+    COMMUINICATION_SEND = 3,      // 发送数据
+    COMMUINICATION_RECV = 4,      // 接收数据
+    COMMUINICATION_SHOW = 5,      // 显示连接信息
+    COMMUINICATION_BROADCAST = 6, // 广播至所有客户端
+    COMMUINICATION_UPLOAD = 7,    // 流式转发：分片逐个转发至接收方，不在服务端重组
 };
 
 #pragma region 日志相关枚举及方法
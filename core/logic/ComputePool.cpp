@@ -0,0 +1,148 @@
+#include "ComputePool.h"
+
+#include "../../infra/log/Logger.h"
+#include "../../infra/metrics/Metrics.h"
+#include "../../config/ConfigManager.h"
+
+namespace
+{
+    // 当前线程在计算线程池中的下标（非计算线程为 -1）
+    thread_local int t_workerIndex = -1;
+}
+
+ComputePool::ComputePool(std::size_t size)
+{
+    LOG_INFO << "ComputePool thread count is " << size << std::endl;
+
+    for (std::size_t i = 0; i < size; i++)
+    {
+        this->_workers.push_back(std::make_unique<Worker>());
+    }
+    for (std::size_t i = 0; i < size; i++)
+    {
+        this->_workers[i]->thread = std::thread(&ComputePool::Run, this, i);
+    }
+}
+
+ComputePool::~ComputePool()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->_idleMutex);
+        this->_isStoped = true;
+    }
+    this->_idleCond.notify_all();
+
+    for (auto &worker : this->_workers)
+    {
+        worker->thread.join();
+    }
+}
+
+ComputePool &ComputePool::GetInstance()
+{
+    static ComputePool instance(std::max<std::size_t>(ConfigManager::GetInstance().GetComputeThreads(), 1));
+    return instance;
+}
+
+void ComputePool::Submit(Task task)
+{
+    // 计算线程内提交的任务放入自己的队列，外部提交的任务轮询分配
+    std::size_t index = t_workerIndex >= 0 ? static_cast<std::size_t>(t_workerIndex)
+                                           : this->_nextIndex++ % this->_workers.size();
+
+    // 先计数再入队：任务一入队就可能被取走并递减计数，先入队会使计数短暂下溢
+    // （在空闲锁内修改，避免工作线程检查计数与挂起之间错过通知）
+    {
+        std::lock_guard<std::mutex> lock(this->_idleMutex);
+        this->_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    {
+        auto &worker = *this->_workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    this->_idleCond.notify_one();
+}
+
+bool ComputePool::IsComputeThread()
+{
+    return t_workerIndex >= 0;
+}
+
+void ComputePool::RunToCompletion(boost::asio::awaitable<void> work)
+{
+    // 每个计算线程复用一个上下文
+    thread_local boost::asio::io_context ioc;
+    boost::asio::co_spawn(ioc, std::move(work), boost::asio::detached);
+    ioc.restart();
+    ioc.run();
+}
+
+bool ComputePool::TakeTask(std::size_t index, Task &task)
+{
+    // 自己的队列：从尾部取（最近提交的任务，缓存更热）
+    {
+        auto &worker = *this->_workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (!worker.tasks.empty())
+        {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            return true;
+        }
+    }
+
+    // 窃取：从其他队列的头部取（最早提交的任务）
+    for (std::size_t i = 1; i < this->_workers.size(); i++)
+    {
+        auto &victim = *this->_workers[(index + i) % this->_workers.size()];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (lock.owns_lock() && !victim.tasks.empty())
+        {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            Metrics::GetInstance().RecordComputeSteal();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ComputePool::Run(std::size_t index)
+{
+    t_workerIndex = static_cast<int>(index);
+
+    Task task;
+    for (;;)
+    {
+        if (TakeTask(index, task))
+        {
+            this->_pending.fetch_sub(1, std::memory_order_relaxed);
+            Metrics::GetInstance().RecordComputeTask();
+            try
+            {
+                task();
+            }
+            catch (const std::exception &e)
+            {
+                LOG_ERROR << "ComputePool: task error: " << e.what() << std::endl;
+            }
+            task = nullptr;
+            continue;
+        }
+
+        // 没有可取的任务：挂起，直至有新任务或停止
+        std::unique_lock<std::mutex> lock(this->_idleMutex);
+        if (this->_isStoped && this->_pending.load(std::memory_order_relaxed) == 0)
+            break;
+        // 有任务但窃取时对方队列被锁住，稍后重试
+        if (this->_pending.load(std::memory_order_relaxed) > 0)
+        {
+            lock.unlock();
+            std::this_thread::yield();
+            continue;
+        }
+        this->_idleCond.wait(lock, [this]()
+                             { return this->_isStoped || this->_pending.load(std::memory_order_relaxed) > 0; });
+    }
+}
@@ -0,0 +1,144 @@
+#ifndef COMPUTEPOOL_H
+#define COMPUTEPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+// 计算线程池（工作窃取）：用于阻塞或 CPU 密集的业务处理，避免占用网络线程
+// 每个工作线程有自己的任务队列：外部提交的任务轮询放入各队列，工作线程内提交的任务放入自己的队列；
+// 工作线程优先从自己的队列尾部取任务，空闲时从其他队列头部窃取
+class ComputePool
+{
+public:
+    using Task = std::function<void()>;
+
+    // 删除拷贝构造函数
+    ComputePool(const ComputePool &) = delete;
+    // 删除赋值构造函数
+    ComputePool &operator=(const ComputePool &) = delete;
+
+    ~ComputePool();
+
+    // 单例
+    static ComputePool &GetInstance();
+
+    // 提交任务（任意线程）
+    void Submit(Task task);
+    // 在当前计算线程中执行协程直至结束（协程中的异步等待在本线程完成）
+    static void RunToCompletion(boost::asio::awaitable<void> work);
+    // 获取线程数量
+    std::size_t GetSize() const { return this->_workers.size(); }
+    // 当前线程是否为计算线程
+    static bool IsComputeThread();
+
+private:
+    ComputePool(std::size_t size);
+
+    // 工作线程
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    // 工作线程主循环
+    void Run(std::size_t index);
+    // 取任务：先取自己队列的尾部，再窃取其他队列的头部
+    bool TakeTask(std::size_t index, Task &task);
+
+    // 工作线程
+    std::vector<std::unique_ptr<Worker>> _workers;
+    // 外部提交时轮询的下标
+    std::atomic<std::size_t> _nextIndex{0};
+    // 尚未取出的任务数（入队前计入，不会小于实际排队数）
+    std::atomic<std::size_t> _pending{0};
+    // 空闲等待
+    std::mutex _idleMutex;
+    std::condition_variable _idleCond;
+    // 是否停止
+    bool _isStoped = false;
+};
+
+// 在计算线程池中执行 fn，完成后回到当前协程的执行器继续，返回 fn 的返回值（fn 抛出的异常在此重新抛出）
+// 用法：auto json = co_await Offload([&]() { return result.MakeResultJson(); });
+template <typename Fn>
+boost::asio::awaitable<std::invoke_result_t<Fn>> Offload(Fn fn)
+{
+    using Result = std::invoke_result_t<Fn>;
+
+    // 已在计算线程中（如计算命令内再次 Offload），直接执行，避免等待自身所在线程
+    if (ComputePool::IsComputeThread())
+    {
+        co_return fn();
+    }
+
+    if constexpr (std::is_void_v<Result>)
+    {
+        co_await boost::asio::async_initiate<const boost::asio::use_awaitable_t<> &, void(std::exception_ptr)>(
+            [&fn](auto handler)
+            {
+                auto executor = boost::asio::get_associated_executor(handler);
+                auto state = std::make_shared<std::pair<Fn, decltype(handler)>>(std::move(fn), std::move(handler));
+                // 保持协程所在的 io_context 在任务完成前不退出
+                auto work = boost::asio::make_work_guard(executor);
+                ComputePool::GetInstance().Submit([state, work]() mutable
+                                                  {
+                                                      std::exception_ptr error;
+                                                      try
+                                                      {
+                                                          state->first();
+                                                      }
+                                                      catch (...)
+                                                      {
+                                                          error = std::current_exception();
+                                                      }
+                                                      boost::asio::post(work.get_executor(), [state, error]() mutable
+                                                                        { std::move(state->second)(error); });
+                                                      work.reset(); });
+            },
+            boost::asio::use_awaitable);
+    }
+    else
+    {
+        // 结果以 optional 传递：fn 抛出异常时没有结果，Result 无需可默认构造
+        auto result = co_await boost::asio::async_initiate<const boost::asio::use_awaitable_t<> &, void(std::exception_ptr, std::optional<Result>)>(
+            [&fn](auto handler)
+            {
+                auto executor = boost::asio::get_associated_executor(handler);
+                auto state = std::make_shared<std::pair<Fn, decltype(handler)>>(std::move(fn), std::move(handler));
+                // 保持协程所在的 io_context 在任务完成前不退出
+                auto work = boost::asio::make_work_guard(executor);
+                ComputePool::GetInstance().Submit([state, work]() mutable
+                                                  {
+                                                      std::exception_ptr error;
+                                                      std::optional<Result> result;
+                                                      try
+                                                      {
+                                                          result.emplace(state->first());
+                                                      }
+                                                      catch (...)
+                                                      {
+                                                          error = std::current_exception();
+                                                      }
+                                                      boost::asio::post(work.get_executor(), [state, error, result = std::move(result)]() mutable
+                                                                        { std::move(state->second)(error, std::move(result)); });
+                                                      work.reset(); });
+            },
+            boost::asio::use_awaitable);
+        co_return std::move(*result);
+    }
+}
+
+#endif // COMPUTEPOOL_H
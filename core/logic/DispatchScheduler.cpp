@@ -0,0 +1,123 @@
+#include "DispatchScheduler.h"
+
+#include <algorithm>
+
+#include "../session/CSession.h"
+#include "../session/AsioIOServicePool.h"
+#include "../../config/ConfigManager.h"
+
+#include "../../services/IService.h"
+
+DispatchScheduler::DispatchScheduler(boost::asio::io_context &ioc, std::size_t maxRunning)
+    : _ioc(ioc),
+      _maxRunning(std::max<std::size_t>(maxRunning, 1))
+{
+}
+
+boost::asio::awaitable<void> DispatchScheduler::Dispatch(IService *service, std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg)
+{
+    auto scheduler = AsioIOServicePool::GetInstance().GetScheduler(session->GetIoContext());
+    // 控制消息（如心跳）不排队等待名额，也不占用名额，直接执行
+    if (!scheduler || ConfigManager::GetInstance().GetPriority(msg->GetServiceId(), msg->GetCmdId()) == PRIORITY_CONTROL)
+        return service->Handle(std::move(session), std::move(msg));
+    return scheduler->Run(service, std::move(session), std::move(msg));
+}
+
+boost::asio::awaitable<void> DispatchScheduler::Run(IService *service, std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg)
+{
+    // 有空闲名额且无人排队，直接执行
+    if (this->_running < this->_maxRunning && this->_activeList.empty())
+    {
+        ++this->_running;
+    }
+    else
+    {
+        // 加入该客户端的队列
+        auto waiter = std::make_shared<Waiter>(this->_ioc);
+        auto key = GetFlowKey(*session);
+        auto [it, created] = this->_flows.try_emplace(key);
+        if (created)
+        {
+            it->second.weight = GetWeight(*session);
+            this->_activeList.push_back(std::move(key));
+        }
+        it->second.waiters.push_back(waiter);
+        ++this->_queued;
+
+        // 等待分配名额（名额由 GrantNext 计入 _running）
+        while (!waiter->granted)
+        {
+            waiter->timer.expires_at(boost::asio::steady_timer::time_point::max());
+            boost::system::error_code ec;
+            co_await waiter->timer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        }
+    }
+
+    try
+    {
+        co_await service->Handle(std::move(session), std::move(msg));
+    }
+    catch (...)
+    {
+        Release();
+        throw;
+    }
+    Release();
+}
+
+void DispatchScheduler::Release()
+{
+    --this->_running;
+    GrantNext();
+}
+
+void DispatchScheduler::GrantNext()
+{
+    while (this->_running < this->_maxRunning && !this->_activeList.empty())
+    {
+        auto &key = this->_activeList.front();
+        auto &flow = this->_flows[key];
+
+        // 轮到该客户端：额度用完时按权重补充
+        if (flow.deficit == 0)
+            flow.deficit = flow.weight;
+
+        // 分配一个名额
+        auto waiter = std::move(flow.waiters.front());
+        flow.waiters.pop_front();
+        --flow.deficit;
+        --this->_queued;
+        ++this->_running;
+        waiter->granted = true;
+        waiter->timer.cancel();
+
+        // 队列已空，移出轮转；额度用完，轮到下一个客户端
+        if (flow.waiters.empty())
+        {
+            this->_flows.erase(key);
+            this->_activeList.pop_front();
+        }
+        else if (flow.deficit == 0)
+        {
+            this->_activeList.push_back(std::move(key));
+            this->_activeList.pop_front();
+        }
+    }
+}
+
+std::string DispatchScheduler::GetFlowKey(CSession &session)
+{
+    // 前缀区分两类队列，名称与会话标识不会冲突
+    auto &name = session.GetClientName();
+    if (name.empty())
+        return "#" + std::to_string(session.GetId());
+    return "@" + name;
+}
+
+uint32_t DispatchScheduler::GetWeight(CSession &session)
+{
+    auto &name = session.GetClientName();
+    if (name.empty())
+        return 1;
+    return ConfigManager::GetInstance().GetClientWeight(name);
+}
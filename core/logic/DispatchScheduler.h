@@ -0,0 +1,85 @@
+#ifndef DISPATCHSCHEDULER_H
+#define DISPATCHSCHEDULER_H
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <boost/asio.hpp>
+
+// 前置声明
+class IService;
+class CSession;
+class MsgNode;
+
+// 请求分发调度器（每个 io_context 一个，仅在该 io_context 线程中访问）
+// 同时执行的回调数受 maxRunning 限制；超出时请求按客户端排队（已注册名称的客户端的多个连接共用一个队列，
+// 未注册名称的会话各自一个队列），以赤字轮转（DRR）在各队列间分配空出的执行名额：每轮按权重补充额度，每个请求消耗 1，
+// 大量流水线请求（或多个连接）的客户端不会挤占其他客户端，权重按客户端名称配置
+class DispatchScheduler
+{
+public:
+    DispatchScheduler(boost::asio::io_context &ioc, std::size_t maxRunning);
+    // 删除拷贝构造函数
+    DispatchScheduler(const DispatchScheduler &) = delete;
+    // 删除赋值构造函数
+    DispatchScheduler &operator=(const DispatchScheduler &) = delete;
+
+    // 分发请求：在会话的 io_context 上通过调度器执行回调（未启用调度时直接执行）
+    // 各会话类型及 LogicSystem 的非阻塞命令统一通过此入口调用 IService::Handle；控制消息不经过调度直接执行
+    // LogicSystem 的阻塞命令不经过调度：调度器运行在会话的 io_context 线程上，阻塞回调会占住该线程
+    static boost::asio::awaitable<void> Dispatch(IService *service, std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg);
+
+    // 当前执行中的回调数 / 排队中的请求数
+    std::size_t GetRunning() const { return this->_running; }
+    std::size_t GetQueued() const { return this->_queued; }
+
+private:
+    // 等待执行名额的请求
+    struct Waiter
+    {
+        explicit Waiter(boost::asio::io_context &ioc) : timer(ioc) {}
+        // 作为通知使用：分配到名额时取消
+        boost::asio::steady_timer timer;
+        bool granted = false;
+    };
+
+    // 一个客户端的排队请求
+    struct Flow
+    {
+        // 权重（每轮补充的额度）
+        uint32_t weight = 1;
+        // 剩余额度
+        uint32_t deficit = 0;
+        // 排队的请求
+        std::deque<std::shared_ptr<Waiter>> waiters;
+    };
+
+    // 执行回调，需要时排队等待名额
+    boost::asio::awaitable<void> Run(IService *service, std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg);
+    // 回调结束，释放名额
+    void Release();
+    // 按赤字轮转分配空出的名额
+    void GrantNext();
+    // 获取会话所属的队列：已注册名称时按名称，否则按会话标识
+    static std::string GetFlowKey(CSession &session);
+    // 获取会话的权重（按客户端名称配置，未注册名称时为 1）
+    static uint32_t GetWeight(CSession &session);
+
+    // 所属 io_context
+    boost::asio::io_context &_ioc;
+    // 最大同时执行数
+    std::size_t _maxRunning;
+    // 当前执行数
+    std::size_t _running = 0;
+    // 排队请求数
+    std::size_t _queued = 0;
+    // 有排队请求的客户端
+    std::unordered_map<std::string, Flow> _flows;
+    // 轮转顺序（队首为当前服务的客户端）
+    std::deque<std::string> _activeList;
+};
+
+#endif // DISPATCHSCHEDULER_H
@@ -2,6 +2,7 @@
 #ifndef LOGICNODE_H
 #define LOGICNODE_H
 
+#include <chrono>
 #include <memory>
 
 // 前置声明
@@ -15,16 +16,20 @@ public:
     LogicNode(std::shared_ptr<CSession> session,
               std::shared_ptr<MsgNode> msg)
         : _session(session),
-          _msg(msg)
+          _msg(msg),
+          _enqueueTime(std::chrono::steady_clock::now())
     {
     }
 
     std::shared_ptr<CSession> GetSession() { return this->_session; }
     std::shared_ptr<MsgNode> GetRecvNode() { return this->_msg; }
+    // 获取投递时间（用于统计排队时长）
+    std::chrono::steady_clock::time_point GetEnqueueTime() const { return this->_enqueueTime; }
 
 private:
     std::shared_ptr<CSession> _session;
     std::shared_ptr<MsgNode> _msg;
+    std::chrono::steady_clock::time_point _enqueueTime;
 };
 
 #endif // LOGICNODE_H
\ No newline at end of file
@@ -1,96 +1,139 @@
 
 #include "LogicSystem.h"
 #include "LogicNode.h"
+#include "DispatchScheduler.h"
 
 #include "../common/Const.h"
 #include "../session/CSession.h"
 
 #include "../../infra/log/Logger.h"
+#include "../../infra/metrics/Metrics.h"
+#include "../../config/ConfigManager.h"
 
 #include "../../services/IService.h"
 #include "../../services/ServiceManager.h"
 
 #include <boost/asio/co_spawn.hpp>
 
+#include <algorithm>
+#include <chrono>
+
 LogicSystem::LogicSystem()
-    : _isStoped(false)
 {
+    // 工作线程数量
+    std::size_t count = std::max<std::size_t>(ConfigManager::GetInstance().GetLogicWorkers(), 1);
+    LOG_INFO << "LogicSystem worker count is " << count << std::endl;
+
+    for (std::size_t i = 0; i < count; i++)
+    {
+        this->_workers.push_back(std::make_unique<Worker>());
+    }
     // 启动工作线程
-    this->_workThread = std::thread(&LogicSystem::ProcessMsg, this);
+    for (auto &worker : this->_workers)
+    {
+        worker->thread = std::thread(&LogicSystem::ProcessMsg, this, std::ref(*worker));
+    }
 }
 
 // 析构函数
 LogicSystem::~LogicSystem()
 {
-    // 更改运行状态
-    this->_isStoped = true;
-    // 唤醒工作线程
-    this->_workCond.notify_one();
+    for (auto &worker : this->_workers)
+    {
+        // 更改运行状态
+        {
+            std::lock_guard<std::mutex> lock(worker->queMutex);
+            worker->isStoped = true;
+        }
+        // 唤醒工作线程
+        worker->workCond.notify_one();
+    }
     // 等待线程结束
-    this->_workThread.join();
+    for (auto &worker : this->_workers)
+    {
+        worker->thread.join();
+    }
 }
 
 // 单例
 LogicSystem &LogicSystem::GetInstance()
 {
-    static LogicSystem instance = LogicSystem();
+    static LogicSystem instance;
     return instance;
 }
 
 // 对外接口
 void LogicSystem::PostMsgToQue(std::shared_ptr<LogicNode> msgNode)
 {
-    // 加锁
-    std::unique_lock<std::mutex> lock(this->_queMutex);
-    this->_msgQue.push(msgNode);
+    // 同一会话固定投递至同一工作线程
+    auto slot = SessionIdAllocator::GetSlot(msgNode->GetSession()->GetId());
+    auto &worker = *this->_workers[slot % this->_workers.size()];
+
+    bool wasEmpty;
+    {
+        // 加锁
+        std::lock_guard<std::mutex> lock(worker.queMutex);
+        wasEmpty = worker.msgQue.empty();
+        worker.msgQue.push_back(std::move(msgNode));
+        // 在锁内计入排队数：工作线程取出后才会扣减，排队数不会短暂回绕为负
+        Metrics::GetInstance().RecordLogicEnqueue();
+    }
 
-    // 如果消息队列恰好为 1，则唤醒工作线程
-    if (this->_msgQue.size() == 1)
+    // 队列由空变为非空时唤醒工作线程（工作线程只在队列为空时挂起）
+    if (wasEmpty)
     {
-        this->_workCond.notify_one();
+        worker.workCond.notify_one();
     }
 }
 
 // 处理消息
-void LogicSystem::ProcessMsg()
+void LogicSystem::ProcessMsg(Worker &worker)
 {
+    // 本线程取出的一批消息（复用容量）
+    std::deque<std::shared_ptr<LogicNode>> batch;
+
     for (;;)
     {
-        // 加锁
-        std::unique_lock<std::mutex> lock(this->_queMutex);
-
-        // 如果队列为空 并且 未停止，则挂起线程，避免反复轮转
-        while (this->_msgQue.empty() && !this->_isStoped)
         {
-            this->_workCond.wait(lock);
-        }
+            // 加锁
+            std::unique_lock<std::mutex> lock(worker.queMutex);
 
-        // 如果停止
-        if (this->_isStoped)
-        {
-            // 队列非空
-            while (!this->_msgQue.empty())
+            // 如果队列为空 并且 未停止，则挂起线程，避免反复轮转
+            while (worker.msgQue.empty() && !worker.isStoped)
             {
-                if (!AssistProcessMsg())
-                    continue;
+                worker.workCond.wait(lock);
             }
-            // 退出最外围的 for 循环
-            break;
-        } // if (this->_isStoped)
 
-        if (!AssistProcessMsg())
-            continue;
+            // 停止且队列已处理完，退出
+            if (worker.msgQue.empty())
+                break;
+
+            // 一次取出全部消息
+            batch.swap(worker.msgQue);
+        }
+
+        // 锁外分发：记录批次大小与每条消息的排队时间
+        auto now = std::chrono::steady_clock::now();
+        uint64_t maxWaitNanos = 0;
+        uint64_t totalWaitNanos = 0;
+        for (auto &node : batch)
+        {
+            auto wait = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - node->GetEnqueueTime()).count());
+            totalWaitNanos += wait;
+            maxWaitNanos = std::max(maxWaitNanos, wait);
+        }
+        Metrics::GetInstance().RecordLogicBatch(batch.size(), totalWaitNanos, maxWaitNanos);
+
+        for (auto &node : batch)
+        {
+            DispatchMsg(worker, node);
+        }
+        batch.clear();
     }
 }
 
-bool LogicSystem::AssistProcessMsg()
+void LogicSystem::DispatchMsg(Worker &worker, const std::shared_ptr<LogicNode> &node)
 {
-    // 此时队列不为空
-    // 获取头节点
-    auto node = _msgQue.front();
-    // 弹出头节点
-    _msgQue.pop();
-
     auto session = node->GetSession();
     auto msgNode = node->GetRecvNode();
     auto &header = msgNode->GetHeader();
@@ -102,7 +145,7 @@ bool LogicSystem::AssistProcessMsg()
     {
         LOG_WARN << "No service for serviceId = "
                  << header.serviceId << std::endl;
-        return false;
+        return;
     }
 
     //
@@ -112,7 +155,20 @@ bool LogicSystem::AssistProcessMsg()
 
     // 获取socket
     auto &socket = session->GetSocket();
-    LOG_INFO << "Get Connention By " << socket.remote_endpoint() << std::endl;
+    boost::system::error_code ec;
+    LOG_INFO << "Get Connention By " << socket.remote_endpoint(ec) << std::endl;
+
+    // 阻塞命令：在本工作线程的上下文中执行至结束（同步调用只阻塞本线程）
+    // 不经过 DispatchScheduler：调度器运行在会话的 io_context 线程上，阻塞回调会占住该线程；
+    // 工作线程逐个执行，同一批次内按入队顺序处理，执行数已由工作线程数限制
+    // 计算命令由 Handle 转至计算线程池执行，按非阻塞命令处理，避免工作线程空等计算线程
+    if (service->IsBlockingCmd(header.cmdId) && !service->IsComputeCmd(header.cmdId))
+    {
+        boost::asio::co_spawn(worker.ioc, service->Handle(session, msgNode), boost::asio::detached);
+        worker.ioc.restart();
+        worker.ioc.run();
+        return;
+    }
 
     // ==============================
     // 投递到 asio 协程执行
@@ -125,9 +181,7 @@ bool LogicSystem::AssistProcessMsg()
 
     boost::asio::co_spawn(
         session->GetIoContext(), // 绑定到该连接的 io_context
-        service->Handle(session, msgNode),
+        DispatchScheduler::Dispatch(service, session, msgNode), // 经由该 io_context 的调度器执行
         boost::asio::detached // 不需要 join / future
     );
-
-    return true;
 }
\ No newline at end of file
@@ -1,21 +1,24 @@
-
 #ifndef LOGICSYSTEM_H
 #define LOGICSYSTEM_H
 
-#include <unordered_map>
-#include <queue>
+#include <deque>
 #include <thread>
 #include <memory>
 #include <string>
+#include <vector>
 #include <functional>
 #include <mutex>
 #include <iostream>
 #include <condition_variable>
 
+#include <boost/asio.hpp>
+
 // 前置声明
 class LogicNode;
 class CSession;
 
+// 逻辑系统：多个工作线程，消息按会话划分至固定的工作线程（同一会话的消息保持到达顺序）
+// 声明为阻塞的命令直接在工作线程中执行，不占用网络线程
 class LogicSystem
 {
 public:
@@ -33,21 +36,31 @@ public:
 
 private:
     LogicSystem();
-    // 处理消息
-    void ProcessMsg();
-    // 处理消息的辅助方法 成功回调返回 true，否则返回 false
-    bool AssistProcessMsg();
 
-    // 逻辑消息队列
-    std::queue<std::shared_ptr<LogicNode>> _msgQue;
     // 工作线程
-    std::thread _workThread;
-    // 互斥量
-    std::mutex _queMutex;
-    // 条件变量，用于在队列为空时，将处理线程短暂挂起，直至有新的消息进来，降低 CPU 的轮转
-    std::condition_variable _workCond;
-    // 是否停止
-    bool _isStoped;
+    struct Worker
+    {
+        // 逻辑消息队列
+        std::deque<std::shared_ptr<LogicNode>> msgQue;
+        // 工作线程
+        std::thread thread;
+        // 互斥量
+        std::mutex queMutex;
+        // 条件变量，用于在队列为空时，将处理线程短暂挂起，直至有新的消息进来，降低 CPU 的轮转
+        std::condition_variable workCond;
+        // 是否停止
+        bool isStoped = false;
+        // 阻塞命令在本线程执行所用的上下文
+        boost::asio::io_context ioc;
+    };
+
+    // 处理消息：每次加锁取出队列中的全部消息，在锁外逐个分发
+    void ProcessMsg(Worker &worker);
+    // 分发一个消息至对应服务：阻塞命令在本工作线程中执行完毕，其余投递至会话的 io_context
+    void DispatchMsg(Worker &worker, const std::shared_ptr<LogicNode> &node);
+
+    // 工作线程（按会话槽位取模划分）
+    std::vector<std::unique_ptr<Worker>> _workers;
 };
 
-#endif // LOGICSYSTEM_H
\ No newline at end of file
+#endif // LOGICSYSTEM_H
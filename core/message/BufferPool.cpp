@@ -0,0 +1,251 @@
+#include "BufferPool.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <new>
+
+// 每个线程、每个等级本地最多缓存的字节数（至少缓存 LOCAL_MIN_BLOCKS 块）
+static constexpr std::size_t LOCAL_LIMIT_BYTES = 256 * 1024;
+static constexpr std::size_t LOCAL_MIN_BLOCKS = 4;
+// 全局链表每个等级最多缓存的字节数，超出部分直接释放
+static constexpr std::size_t GLOBAL_LIMIT_BYTES = 16 * 1024 * 1024;
+
+// 获取某等级本地链表的块数上限
+static std::size_t GetLocalLimit(std::size_t index)
+{
+    std::size_t blockSize = BufferPool::MIN_CLASS_SIZE << index;
+    return std::max(LOCAL_MIN_BLOCKS, LOCAL_LIMIT_BYTES / blockSize);
+}
+
+// 线程本地空闲链表
+struct BufferPool::LocalCache
+{
+    std::array<std::vector<void *>, CLASS_COUNT> lists;
+
+    ~LocalCache();
+};
+
+namespace
+{
+    // 线程本地链表是否已析构（平凡类型，析构后仍可安全读取）
+    thread_local bool t_cacheDestroyed = false;
+    // 当前线程所在的 NUMA 节点
+    thread_local std::size_t t_node = 0;
+}
+
+void BufferPool::SetThreadNode(int node)
+{
+    t_node = node < 0 ? 0 : static_cast<std::size_t>(node) % MAX_NUMA_NODES;
+}
+
+BufferPool::GlobalList &BufferPool::GetGlobalList(std::size_t index)
+{
+    return this->_globalLists[t_node][index];
+}
+
+BufferPool::LocalCache::~LocalCache()
+{
+    // 线程退出，将本地缓存全部归还至全局链表
+    for (std::size_t i = 0; i < CLASS_COUNT; ++i)
+    {
+        if (!this->lists[i].empty())
+        {
+            BufferPool::GetInstance().ReturnToGlobal(i, this->lists[i], this->lists[i].size());
+        }
+    }
+    t_cacheDestroyed = true;
+}
+
+BufferPool &BufferPool::GetInstance()
+{
+    static BufferPool instance;
+    return instance;
+}
+
+BufferPool::LocalCache *BufferPool::GetLocalCache()
+{
+    // 线程退出后（本地链表已析构）仍可能有内存归还，此时直接走全局链表
+    if (t_cacheDestroyed)
+        return nullptr;
+
+    thread_local LocalCache cache;
+    return &cache;
+}
+
+std::size_t BufferPool::GetClassIndex(std::size_t size)
+{
+    if (size <= MIN_CLASS_SIZE)
+        return 0;
+    if (size > MAX_CLASS_SIZE)
+        return CLASS_COUNT;
+
+    // 向上取整到 2 的幂后计算等级
+    return std::bit_width(size - 1) - std::bit_width(MIN_CLASS_SIZE - 1);
+}
+
+std::size_t BufferPool::GetClassSize(std::size_t size)
+{
+    auto index = GetClassIndex(size);
+    if (index >= CLASS_COUNT)
+        return size;
+    return MIN_CLASS_SIZE << index;
+}
+
+void *BufferPool::Allocate(std::size_t size)
+{
+    auto index = GetClassIndex(size);
+
+    // 超出最大等级，直接向系统申请
+    if (index >= CLASS_COUNT)
+    {
+        this->_oversize.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    auto cache = GetLocalCache();
+    if (cache)
+    {
+        auto &list = cache->lists[index];
+
+        // 本地链表为空，从全局链表批量取回一半上限的块
+        if (list.empty() && FetchFromGlobal(index, list, GetLocalLimit(index) / 2) > 0)
+        {
+            this->_globalHits.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (!list.empty())
+        {
+            this->_localHits.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (!list.empty())
+        {
+            void *ptr = list.back();
+            list.pop_back();
+            return ptr;
+        }
+    }
+    else
+    {
+        std::vector<void *> one;
+        if (FetchFromGlobal(index, one, 1) > 0)
+        {
+            this->_globalHits.fetch_add(1, std::memory_order_relaxed);
+            return one.back();
+        }
+    }
+
+    // 未命中，按等级大小向系统申请
+    this->_misses.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(MIN_CLASS_SIZE << index);
+}
+
+void BufferPool::Deallocate(void *ptr, std::size_t size)
+{
+    if (ptr == nullptr)
+        return;
+
+    auto index = GetClassIndex(size);
+
+    // 超出最大等级，直接释放
+    if (index >= CLASS_COUNT)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto cache = GetLocalCache();
+    // 线程退出阶段，直接归还全局链表
+    if (!cache)
+    {
+        std::vector<void *> one{ptr};
+        ReturnToGlobal(index, one, 1);
+        return;
+    }
+
+    auto &list = cache->lists[index];
+    list.push_back(ptr);
+
+    // 超出本地上限，将一半归还至全局链表，供其他线程（io_context）使用
+    auto limit = GetLocalLimit(index);
+    if (list.size() > limit)
+    {
+        ReturnToGlobal(index, list, list.size() - limit / 2);
+    }
+}
+
+std::size_t BufferPool::FetchFromGlobal(std::size_t index, std::vector<void *> &out, std::size_t count)
+{
+    auto &global = GetGlobalList(index);
+
+    std::lock_guard<std::mutex> lock(global.mutex);
+    count = std::min(count, global.blocks.size());
+    out.insert(out.end(), global.blocks.end() - count, global.blocks.end());
+    global.blocks.resize(global.blocks.size() - count);
+    return count;
+}
+
+void BufferPool::ReturnToGlobal(std::size_t index, std::vector<void *> &blocks, std::size_t count)
+{
+    auto &global = GetGlobalList(index);
+    auto limit = GLOBAL_LIMIT_BYTES / (MIN_CLASS_SIZE << index);
+
+    std::size_t keep = 0;
+    {
+        std::lock_guard<std::mutex> lock(global.mutex);
+        // 全局链表容量有限，多余的块直接释放
+        keep = std::min(count, limit > global.blocks.size() ? limit - global.blocks.size() : 0);
+        global.blocks.insert(global.blocks.end(), blocks.end() - keep, blocks.end());
+    }
+    blocks.resize(blocks.size() - keep);
+
+    for (std::size_t i = keep; i < count; ++i)
+    {
+        ::operator delete(blocks.back());
+        blocks.pop_back();
+    }
+}
+
+BufferPool::Stats BufferPool::GetStats() const
+{
+    return Stats{
+        this->_localHits.load(std::memory_order_relaxed),
+        this->_globalHits.load(std::memory_order_relaxed),
+        this->_misses.load(std::memory_order_relaxed),
+        this->_oversize.load(std::memory_order_relaxed)};
+}
+
+void PooledBuffer::Resize(std::size_t size)
+{
+    // 容量足够，直接调整大小
+    if (size <= this->_capacity)
+    {
+        this->_size = size;
+        return;
+    }
+
+    // 从内存池申请新块，并保留原有内容
+    auto &pool = BufferPool::GetInstance();
+    std::size_t capacity = BufferPool::GetClassSize(size);
+    char *data = static_cast<char *>(pool.Allocate(capacity));
+    if (this->_size > 0)
+    {
+        std::memcpy(data, this->_data, this->_size);
+    }
+
+    Release();
+    this->_data = data;
+    this->_size = size;
+    this->_capacity = capacity;
+}
+
+void PooledBuffer::Release()
+{
+    if (this->_data)
+    {
+        BufferPool::GetInstance().Deallocate(this->_data, this->_capacity);
+    }
+    this->_data = nullptr;
+    this->_size = 0;
+    this->_capacity = 0;
+}
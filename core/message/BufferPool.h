@@ -0,0 +1,171 @@
+#ifndef BUFFERPOOL_H
+#define BUFFERPOOL_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// 分级内存池
+// 按 2 的幂划分大小等级（64B ~ 1MB），每个线程持有本地空闲链表（每个 io_context 独占一个线程，
+// 即相当于每个 io_context 一份），本地链表超出上限时批量归还至全局溢出链表，本地不足时再从全局批量取回
+// 全局溢出链表按 NUMA 节点划分，线程只与所在节点的链表交换内存块，避免跨节点复用
+// 超过最大等级的申请直接走 operator new，不做缓存
+class BufferPool
+{
+public:
+    // 最小等级的块大小
+    static constexpr std::size_t MIN_CLASS_SIZE = 64;
+    // 大小等级数量（64B << 14 = 1MB）
+    static constexpr std::size_t CLASS_COUNT = 15;
+    // 最大等级的块大小
+    static constexpr std::size_t MAX_CLASS_SIZE = MIN_CLASS_SIZE << (CLASS_COUNT - 1);
+    // 全局溢出链表划分的 NUMA 节点数（节点号超出时取模）
+    static constexpr std::size_t MAX_NUMA_NODES = 8;
+
+    // 统计信息
+    struct Stats
+    {
+        uint64_t localHits;  // 命中线程本地链表
+        uint64_t globalHits; // 命中全局溢出链表
+        uint64_t misses;     // 未命中，向系统申请
+        uint64_t oversize;   // 超出最大等级，直接向系统申请
+    };
+
+    // 删除拷贝构造函数
+    BufferPool(const BufferPool &) = delete;
+    // 删除赋值构造函数
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    // 单例
+    static BufferPool &GetInstance();
+
+    // 申请内存，实际可用大小为 GetClassSize(size)
+    void *Allocate(std::size_t size);
+    // 归还内存，size 必须与申请时一致（或同一等级）
+    void Deallocate(void *ptr, std::size_t size);
+
+    // 获取统计信息
+    Stats GetStats() const;
+
+    // 设置当前线程所在的 NUMA 节点（绑核后调用，未知时为 0）
+    static void SetThreadNode(int node);
+
+    // 获取 size 向上取整后的块大小（超出最大等级时原样返回）
+    static std::size_t GetClassSize(std::size_t size);
+    // 获取 size 对应的等级下标（超出最大等级时返回 CLASS_COUNT）
+    static std::size_t GetClassIndex(std::size_t size);
+
+private:
+    BufferPool() = default;
+
+    // 线程本地空闲链表（定义见 BufferPool.cpp）
+    struct LocalCache;
+    // 获取当前线程的本地链表，线程退出阶段返回 nullptr
+    static LocalCache *GetLocalCache();
+
+    // 从全局链表取回至多 count 个块，返回实际数量
+    std::size_t FetchFromGlobal(std::size_t index, std::vector<void *> &out, std::size_t count);
+    // 将 blocks 末尾的 count 个块归还至全局链表
+    void ReturnToGlobal(std::size_t index, std::vector<void *> &blocks, std::size_t count);
+
+    // 全局溢出链表（按 NUMA 节点、等级）
+    struct GlobalList
+    {
+        std::mutex mutex;
+        std::vector<void *> blocks;
+    };
+    // 获取当前线程所在节点的全局链表
+    GlobalList &GetGlobalList(std::size_t index);
+    std::array<std::array<GlobalList, CLASS_COUNT>, MAX_NUMA_NODES> _globalLists;
+
+    // 统计计数器
+    std::atomic<uint64_t> _localHits{0};
+    std::atomic<uint64_t> _globalHits{0};
+    std::atomic<uint64_t> _misses{0};
+    std::atomic<uint64_t> _oversize{0};
+};
+
+// 由内存池管理的连续缓冲区（仅可移动）
+class PooledBuffer
+{
+public:
+    PooledBuffer() = default;
+    explicit PooledBuffer(std::size_t size) { Resize(size); }
+    ~PooledBuffer() { Release(); }
+
+    // 删除拷贝构造函数
+    PooledBuffer(const PooledBuffer &) = delete;
+    // 删除赋值构造函数
+    PooledBuffer &operator=(const PooledBuffer &) = delete;
+
+    PooledBuffer(PooledBuffer &&other) noexcept
+        : _data(other._data), _size(other._size), _capacity(other._capacity)
+    {
+        other._data = nullptr;
+        other._size = 0;
+        other._capacity = 0;
+    }
+
+    PooledBuffer &operator=(PooledBuffer &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            this->_data = other._data;
+            this->_size = other._size;
+            this->_capacity = other._capacity;
+            other._data = nullptr;
+            other._size = 0;
+            other._capacity = 0;
+        }
+        return *this;
+    }
+
+    // 调整大小，容量不足时从内存池申请更大的块（保留原有内容）
+    void Resize(std::size_t size);
+    // 归还内存至内存池
+    void Release();
+
+    char *data() { return this->_data; }
+    const char *data() const { return this->_data; }
+    std::size_t size() const { return this->_size; }
+    std::size_t capacity() const { return this->_capacity; }
+    bool empty() const { return this->_size == 0; }
+
+private:
+    char *_data = nullptr;
+    std::size_t _size = 0;
+    std::size_t _capacity = 0;
+};
+
+// 标准分配器适配，用于 std::allocate_shared 等场景，使对象本身（含控制块）也来自内存池
+template <typename T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    PoolAllocator() noexcept = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U> &) noexcept {}
+
+    T *allocate(std::size_t n)
+    {
+        return static_cast<T *>(BufferPool::GetInstance().Allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T *ptr, std::size_t n)
+    {
+        BufferPool::GetInstance().Deallocate(ptr, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U> &) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U> &) const noexcept { return false; }
+};
+
+#endif // BUFFERPOOL_H
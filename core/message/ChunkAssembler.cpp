@@ -0,0 +1,73 @@
+#include "ChunkAssembler.h"
+
+#include <algorithm>
+#include <cstring>
+
+ChunkAssembler::ChunkAssembler(std::size_t budget)
+    : _pendingBytes(0),
+      _budget(budget)
+{
+}
+
+ChunkAssembler::Result ChunkAssembler::Feed(std::shared_ptr<MsgNode> &msg)
+{
+    auto &header = msg->GetHeader();
+    bool more = header.HasFlag(HEADER_FLAG_MORE);
+
+    // 快速路径：未分片的普通帧（无未完成消息时不计算键）
+    if (this->_partials.empty() && !more)
+        return Result::Complete;
+
+    auto key = header.GetMessageKey();
+    auto it = this->_partials.find(key);
+    if (it == this->_partials.end() && !more)
+        return Result::Complete;
+
+    // 检查重组预算
+    if (this->_pendingBytes + header.length > this->_budget)
+        return Result::Overflow;
+
+    // 首个分片，记录 Header
+    if (it == this->_partials.end())
+    {
+        Partial partial;
+        partial.header = header;
+        partial.body = std::allocate_shared<PooledBuffer>(PoolAllocator<PooledBuffer>());
+        it = this->_partials.emplace(key, std::move(partial)).first;
+    }
+
+    // 追加分片内容（超出容量时按倍数扩容，避免逐片重新分配）
+    auto &body = *it->second.body;
+    std::size_t offset = body.size();
+    std::size_t need = offset + header.length;
+    if (need > body.capacity())
+    {
+        body.Resize(std::max(need, body.capacity() * 2));
+    }
+    body.Resize(need);
+    std::memcpy(body.data() + offset, msg->GetBody(), header.length);
+    this->_pendingBytes += header.length;
+
+    // 还有后续分片
+    if (more)
+        return Result::Pending;
+
+    // 最后一个分片，构造完整的消息节点
+    auto partial = std::move(it->second);
+    this->_partials.erase(it);
+    this->_pendingBytes -= partial.body->size();
+
+    auto node = MsgNode::Create();
+    node->GetHeader() = partial.header;
+    node->GetHeader().SetFlag(HEADER_FLAG_MORE, false);
+    node->SetBodyView(partial.body, partial.body->data(), static_cast<uint32_t>(partial.body->size()));
+
+    msg = std::move(node);
+    return Result::Complete;
+}
+
+void ChunkAssembler::Clear()
+{
+    this->_partials.clear();
+    this->_pendingBytes = 0;
+}
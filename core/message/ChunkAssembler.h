@@ -0,0 +1,61 @@
+#ifndef CHUNKASSEMBLER_H
+#define CHUNKASSEMBLER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+#include "MsgNode.h"
+#include "BufferPool.h"
+
+// 分片重组器（每个会话一份，仅由读取方访问，无需加锁）
+// 带 HEADER_FLAG_MORE 的帧为同一 (serviceId, cmdId, seq) 逻辑消息的中间分片，最后一个分片不带该标志
+// （客户端可能复用 seq，其他服务或命令的帧即使 seq 相同也不会并入未完成的消息）
+// 分片按到达顺序追加，所有未完成消息的累计字节数受 budget 限制，超出即视为异常连接
+class ChunkAssembler
+{
+public:
+    // 处理结果
+    enum class Result
+    {
+        Complete, // 消息完整，可以分发
+        Pending,  // 分片已缓存，等待后续分片
+        Overflow  // 超出重组预算
+    };
+
+    // 显式构造函数，指定重组预算（字节）
+    explicit ChunkAssembler(std::size_t budget);
+
+    // 删除拷贝构造函数
+    ChunkAssembler(const ChunkAssembler &) = delete;
+    // 删除赋值构造函数
+    ChunkAssembler &operator=(const ChunkAssembler &) = delete;
+
+    // 输入一个帧，返回 Complete 时 msg 被替换为重组后的完整消息（未分片的帧原样返回）
+    Result Feed(std::shared_ptr<MsgNode> &msg);
+
+    // 获取尚未完成重组的累计字节数
+    std::size_t GetPendingBytes() const { return this->_pendingBytes; }
+    // 丢弃所有未完成的消息
+    void Clear();
+
+private:
+    // 未完成的逻辑消息
+    struct Partial
+    {
+        // 首个分片的 Header
+        MessageHeader header;
+        // 已接收的消息体（完成后以视图形式交给消息节点，不再拷贝）
+        std::shared_ptr<PooledBuffer> body;
+    };
+
+    // MessageHeader::GetMessageKey (serviceId, cmdId, seq) -> 未完成的消息
+    std::unordered_map<uint64_t, Partial> _partials;
+    // 未完成消息的累计字节数
+    std::size_t _pendingBytes;
+    // 重组预算
+    std::size_t _budget;
+};
+
+#endif // CHUNKASSEMBLER_H
@@ -3,17 +3,29 @@
 #include "../../infra/log/Logger.h"
 
 #include <sstream>
+#include <string_view>
 #include <iomanip> // 用于 std::hex、std::setw、std::setfill
 
+std::shared_ptr<MsgNode> MsgNode::Create()
+{
+    return std::allocate_shared<MsgNode>(PoolAllocator<MsgNode>());
+}
+
+std::shared_ptr<MsgNode> MsgNode::Create(uint32_t bodyLen)
+{
+    return std::allocate_shared<MsgNode>(PoolAllocator<MsgNode>(), bodyLen);
+}
+
 // 内存管理方法
 void MsgNode::Allocate(uint32_t bodyLen)
 {
-    // 重置消息体长度
-    this->_body.resize(bodyLen + 1);
-    // 初始化缓冲区（避免内存残留脏数据）
-    std::memset(this->_body.data(), 0, bodyLen + 1);
+    // 释放视图
+    this->_bodyView = nullptr;
+    this->_bodyHolder.reset();
+    // 重置消息体长度（从内存池获取，消息体随后会被完整写入，无需整体清零）
+    this->_body.Resize(bodyLen + 1);
     // 添加字符串结束符，用于调试打印
-    this->_body[bodyLen] = '\0';
+    this->_body.data()[bodyLen] = '\0';
     // 重置消息头信息
     this->_header.length = bodyLen;
 }
@@ -21,34 +33,20 @@ void MsgNode::Allocate(uint32_t bodyLen)
 //
 void MsgNode::Clear()
 {
-    this->_body.clear();
-    // 释放vector多余容量
-    this->_body.shrink_to_fit();
+    // 保留容量，避免每次读取都释放并重新申请
+    this->_body.Resize(0);
+    this->_bodyView = nullptr;
+    this->_bodyHolder.reset();
     std::memset(&this->_header, 0, sizeof(this->_header));
 }
 
-void MsgNode::BuildSendBuffer()
+void MsgNode::SetBodyView(std::shared_ptr<const void> holder, char *data, uint32_t bodyLen)
 {
-    uint32_t realLen = 0;
-    if (!this->_body.empty())
-    {
-        // 在 Allocate 时，末尾添加了 \0，所以实际长度要减1
-        // 实际 header 中，存储的长度不包括 \0
-        realLen = static_cast<uint32_t>(this->_body.size() - 1);
-    }
-
-    // 1. 设置缓冲区大小 (Header + 真实Body)
-    this->_sendBuf.resize(sizeof(MessageHeader) + realLen);
-
-    // 2. 拷贝 Header (已经是网络序，直接拷贝)
-    std::memcpy(this->_sendBuf.data(), &this->_header, sizeof(MessageHeader));
-
-    // 3. 拷贝 Body (只拷贝真实数据，丢弃末尾的 \0)
-    if (realLen > 0)
-    {
-        std::memcpy(this->_sendBuf.data() + sizeof(MessageHeader),
-                    this->_body.data(), realLen);
-    }
+    // 归还自有内存
+    this->_body.Release();
+    this->_bodyHolder = std::move(holder);
+    this->_bodyView = data;
+    this->_header.length = bodyLen;
 }
 
 // 输出方法
@@ -72,8 +70,8 @@ void MsgNode::Print() const
             << "]";
 
         LOG_INFO << oss.str() << std::endl;
-        // 转为
+        // 消息体视图不含结束符，按长度输出
         LOG_INFO << "\n"
-                 << this->_body.data() << std::endl;
+                 << std::string_view(this->GetBody(), this->GetBodyLen()) << std::endl;
     }
 }
\ No newline at end of file
@@ -3,17 +3,23 @@
 #define MSGNODE_H
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <string.h>
 #include <vector>
 
 #include "../protocol/MessageHeader.h"
+#include "BufferPool.h"
 
 // 消息节点
-// 使用 std::vector<char> 管理内存
+// 消息体由 BufferPool 分级内存池管理，或以视图形式引用接收缓冲区（无拷贝）
 class MsgNode
 {
 public:
+    // 工厂方法：节点对象本身（含 shared_ptr 控制块）同样来自内存池
+    static std::shared_ptr<MsgNode> Create();
+    static std::shared_ptr<MsgNode> Create(uint32_t bodyLen);
+
     // 默认构造函数
     MsgNode() = default;
 
@@ -25,7 +31,7 @@ public:
 
     // 内存管理方法
     void Allocate(uint32_t bodyLen);
-    // 释放内存
+    // 重置节点（保留已申请的容量，供下一次读取复用）
     void Clear();
 
     // 头部访问方法
@@ -38,29 +44,27 @@ public:
 
     // 消息体访问方法
 
-    char *GetBody() { return this->_body.data(); }
-    const char *GetBody() const { return this->_body.data(); }
+    char *GetBody() { return this->_bodyView ? this->_bodyView : this->_body.data(); }
+    const char *GetBody() const { return this->_bodyView ? this->_bodyView : this->_body.data(); }
     uint32_t GetBodyLen() const { return this->_header.length; }
+    // 以视图形式引用外部内存作为消息体，holder 保证内存在节点存活期间有效
+    void SetBodyView(std::shared_ptr<const void> holder, char *data, uint32_t bodyLen);
 
     // Header buffer
 
     char *GetHeaderData() { return reinterpret_cast<char *>(&_header); }
     constexpr static std::size_t GetHeaderSize() { return sizeof(MessageHeader); }
 
-    // Send buffer
-
-    void BuildSendBuffer();
-    const char *GetSendData() { return this->_sendBuf.data(); }
-    std::size_t GetSendSize() const { return this->_sendBuf.size(); }
-
     // 输出方法
     void Print() const;
 
 protected:
     MessageHeader _header{};
-    std::vector<char> _body;
-
-    std::vector<char> _sendBuf; // Header + Body
+    PooledBuffer _body;
+    // 消息体视图（非空时优先于 _body）
+    char *_bodyView = nullptr;
+    // 视图所引用内存的持有者
+    std::shared_ptr<const void> _bodyHolder;
 };
 
 #endif // MSGNODE_H
\ No newline at end of file
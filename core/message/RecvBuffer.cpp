@@ -0,0 +1,110 @@
+#include "RecvBuffer.h"
+
+#include <algorithm>
+#include <cstring>
+
+// 尾部可写空间低于该值时，先整理缓冲区再读取
+static constexpr std::size_t MIN_READ_SPACE = 512;
+
+RecvBuffer::RecvBuffer(std::size_t capacity, std::size_t maxFrameSize)
+    : _block(NewBlock(capacity)),
+      _readPos(0),
+      _writePos(0),
+      _capacity(capacity),
+      _maxFrameSize(maxFrameSize),
+      _frameTooLarge(false)
+{
+}
+
+boost::asio::mutable_buffer RecvBuffer::PrepareWrite()
+{
+    // 尾部空间不足，整理出至少一个默认块的可写空间
+    if (this->_block->size() - this->_writePos < MIN_READ_SPACE)
+    {
+        Reserve(this->GetReadableSize() + this->_capacity);
+    }
+
+    return boost::asio::buffer(this->_block->data() + this->_writePos,
+                               this->_block->size() - this->_writePos);
+}
+
+void RecvBuffer::Commit(std::size_t len)
+{
+    this->_writePos += len;
+}
+
+std::shared_ptr<MsgNode> RecvBuffer::PopFrame()
+{
+    // 头部尚未完整
+    if (this->GetReadableSize() < MsgNode::GetHeaderSize())
+        return nullptr;
+
+    // 拷贝头部并转为本地字节序
+    MessageHeader header;
+    std::memcpy(&header, this->_block->data() + this->_readPos, MsgNode::GetHeaderSize());
+    header.ToHost();
+
+    // 帧超长，不再为其预留空间
+    if (header.length > this->_maxFrameSize)
+    {
+        this->_frameTooLarge = true;
+        return nullptr;
+    }
+
+    std::size_t frameLen = MsgNode::GetHeaderSize() + header.length;
+
+    // 消息体尚未完整，提前预留整帧空间，后续读取直接写入
+    if (this->GetReadableSize() < frameLen)
+    {
+        Reserve(frameLen);
+        return nullptr;
+    }
+
+    // 构造消息节点，消息体直接引用缓冲区
+    auto node = MsgNode::Create();
+    node->GetHeader() = header;
+    node->SetBodyView(this->_block,
+                      this->_block->data() + this->_readPos + MsgNode::GetHeaderSize(),
+                      header.length);
+
+    this->_readPos += frameLen;
+
+    // 已全部解析，且没有视图引用当前块时，直接复用整块
+    if (this->_readPos == this->_writePos && this->_block.use_count() == 1)
+    {
+        this->_readPos = 0;
+        this->_writePos = 0;
+    }
+
+    return node;
+}
+
+void RecvBuffer::Reserve(std::size_t need)
+{
+    // 空间足够
+    if (this->_block->size() - this->_readPos >= need)
+        return;
+
+    std::size_t readable = this->GetReadableSize();
+
+    // 没有视图引用当前块，且容量足够，原地整理
+    if (this->_block.use_count() == 1 && this->_block->size() >= need)
+    {
+        std::memmove(this->_block->data(), this->_block->data() + this->_readPos, readable);
+    }
+    // 当前块仍被业务层引用（或容量不足），换新块，只拷贝未解析的部分
+    else
+    {
+        auto block = NewBlock(std::max(need, this->_capacity));
+        std::memcpy(block->data(), this->_block->data() + this->_readPos, readable);
+        this->_block = std::move(block);
+    }
+
+    this->_readPos = 0;
+    this->_writePos = readable;
+}
+
+std::shared_ptr<PooledBuffer> RecvBuffer::NewBlock(std::size_t size)
+{
+    return std::allocate_shared<PooledBuffer>(PoolAllocator<PooledBuffer>(), size);
+}
@@ -0,0 +1,61 @@
+#ifndef RECVBUFFER_H
+#define RECVBUFFER_H
+
+#include <memory>
+#include <boost/asio.hpp>
+
+#include "MsgNode.h"
+#include "BufferPool.h"
+
+// 会话接收缓冲区
+// 使用 async_read_some 批量填充，一次读取后解析出所有已完整到达的 Header + Body
+// 解析出的消息体不做拷贝，直接以视图的形式引用缓冲区内存（通过引用计数保持存活）
+//
+// 注意：为保证每一帧在内存中连续（可以直接交给业务层），这里不做环形回绕，
+//      而是在尾部空间不足时整理（memmove）或换新块，仅搬移最后一个不完整的帧
+class RecvBuffer
+{
+public:
+    // 构造函数，指定缓冲块的默认大小与单帧消息体的最大长度
+    RecvBuffer(std::size_t capacity, std::size_t maxFrameSize);
+
+    // 删除拷贝构造函数
+    RecvBuffer(const RecvBuffer &) = delete;
+    // 删除赋值构造函数
+    RecvBuffer &operator=(const RecvBuffer &) = delete;
+
+    // 获取可写入区域，用于 async_read_some
+    boost::asio::mutable_buffer PrepareWrite();
+    // 提交本次实际读取到的字节数
+    void Commit(std::size_t len);
+
+    // 尝试解析一个完整的消息帧，数据不完整（或帧超长）时返回 nullptr
+    std::shared_ptr<MsgNode> PopFrame();
+    // 是否收到了超过最大长度的帧（此时连接应当关闭，缓冲区不再可用）
+    bool IsFrameTooLarge() const { return this->_frameTooLarge; }
+
+    // 获取尚未解析的字节数
+    std::size_t GetReadableSize() const { return this->_writePos - this->_readPos; }
+
+private:
+    // 保证从 _readPos 开始至少能容纳 need 字节，必要时整理或换新块
+    void Reserve(std::size_t need);
+
+    // 申请新的缓冲块（块与控制块均来自内存池）
+    static std::shared_ptr<PooledBuffer> NewBlock(std::size_t size);
+
+    // 当前缓冲块，消息体视图共享此块
+    std::shared_ptr<PooledBuffer> _block;
+    // 读位置（下一帧的起点）
+    std::size_t _readPos;
+    // 写位置（已接收数据的末尾）
+    std::size_t _writePos;
+    // 默认缓冲块大小
+    std::size_t _capacity;
+    // 单帧消息体的最大长度，防止伪造的长度字段导致超大内存分配
+    std::size_t _maxFrameSize;
+    // 收到超长帧
+    bool _frameTooLarge;
+};
+
+#endif // RECVBUFFER_H
@@ -0,0 +1,66 @@
+#include "SendNode.h"
+#include "BufferPool.h"
+
+#include <cstring>
+
+std::shared_ptr<SendNode> SendNode::Create(const MessageHeader &header, std::string &&body)
+{
+    return std::allocate_shared<SendNode>(PoolAllocator<SendNode>(), header, std::move(body));
+}
+
+std::shared_ptr<SendNode> SendNode::Create(const MessageHeader &header,
+                                           std::shared_ptr<const void> holder,
+                                           const char *data,
+                                           uint32_t len)
+{
+    return std::allocate_shared<SendNode>(PoolAllocator<SendNode>(), header, std::move(holder), data, len);
+}
+
+std::shared_ptr<SendNode> SendNode::Create(std::shared_ptr<const SharedFrame> frame)
+{
+    return std::allocate_shared<SendNode>(PoolAllocator<SendNode>(), std::move(frame));
+}
+
+SendNode::SendNode(const MessageHeader &header, std::string &&body)
+    : _ownedBody(std::move(body))
+{
+    // 必须在消息体移动到节点内之后再取地址（短字符串存放于对象内部）
+    this->_bodyData = this->_ownedBody.data();
+    this->_bodyLen = static_cast<uint32_t>(this->_ownedBody.size());
+    SetHeader(header);
+}
+
+SendNode::SendNode(const MessageHeader &header, std::shared_ptr<const void> holder, const char *data, uint32_t len)
+    : _holder(std::move(holder)),
+      _bodyData(data),
+      _bodyLen(len)
+{
+    SetHeader(header);
+}
+
+SendNode::SendNode(std::shared_ptr<const SharedFrame> frame)
+    : _header{},
+      _headerData(frame->GetHeaderData()),
+      _bodyData(frame->GetBody()),
+      _bodyLen(frame->GetBodyLen())
+{
+    // 共享帧的 Header 为网络字节序，取出分片标志需先转换
+    MessageHeader header;
+    std::memcpy(&header, frame->GetHeaderData(), sizeof(MessageHeader));
+    header.ToHost();
+    this->_more = header.HasFlag(HEADER_FLAG_MORE);
+
+    // 最后再转交持有权（成员按声明顺序初始化，_holder 先于 _bodyData）
+    this->_holder = std::move(frame);
+}
+
+void SendNode::SetHeader(const MessageHeader &header)
+{
+    this->_header = header;
+    this->_key = header.GetMessageKey();
+    this->_more = header.HasFlag(HEADER_FLAG_MORE);
+    // 以实际消息体长度为准
+    this->_header.length = this->_bodyLen;
+    // 转网络字节序（只在发送前做一次）
+    this->_header.ToNetwork();
+}
@@ -0,0 +1,92 @@
+#ifndef SENDNODE_H
+#define SENDNODE_H
+
+#include <array>
+#include <memory>
+#include <string>
+#include <boost/asio.hpp>
+
+#include "../protocol/MessageHeader.h"
+#include "../common/Const.h"
+#include "SharedFrame.h"
+
+// 发送节点
+// Header 存放于固定槽位（网络字节序），Body 以移动或引用计数的方式持有，不再拼接到连续缓冲区
+// 发送时以 scatter/gather 缓冲序列（Header + Body）直接写入 socket
+class SendNode
+{
+public:
+    // 工厂方法：消息体以移动方式转交给节点（节点对象来自内存池）
+    static std::shared_ptr<SendNode> Create(const MessageHeader &header, std::string &&body);
+    // 工厂方法：消息体引用外部内存，holder 保证发送完成前内存有效
+    static std::shared_ptr<SendNode> Create(const MessageHeader &header,
+                                            std::shared_ptr<const void> holder,
+                                            const char *data,
+                                            uint32_t len);
+    // 工厂方法：引用已编码的共享帧（Header 与 Body 均不拷贝），用于广播
+    static std::shared_ptr<SendNode> Create(std::shared_ptr<const SharedFrame> frame);
+
+    // 构造函数（请使用工厂方法）
+    SendNode(const MessageHeader &header, std::string &&body);
+    SendNode(const MessageHeader &header, std::shared_ptr<const void> holder, const char *data, uint32_t len);
+    explicit SendNode(std::shared_ptr<const SharedFrame> frame);
+
+    // 删除拷贝构造函数
+    SendNode(const SendNode &) = delete;
+    // 删除赋值构造函数
+    SendNode &operator=(const SendNode &) = delete;
+
+    // 获取 Header + Body 的缓冲序列
+    std::array<boost::asio::const_buffer, 2> GetBuffers() const
+    {
+        return {boost::asio::buffer(this->_headerData, sizeof(MessageHeader)),
+                boost::asio::buffer(this->_bodyData, this->_bodyLen)};
+    }
+    // 获取需要发送的总字节数
+    std::size_t GetSendSize() const { return sizeof(MessageHeader) + this->_bodyLen; }
+    // 获取逻辑消息的键 (serviceId, cmdId, seq)（见 MessageHeader::GetMessageKey），用于按请求顺序释放响应
+    uint64_t GetMessageKey() const { return this->_key; }
+
+    // 是否为主动推送（如转发），推送不参与请求响应的顺序释放
+    bool IsPush() const { return this->_push; }
+    void SetPush(bool push) { this->_push = push; }
+
+    // 分片链：同一消息的后续分片挂在首个分片之后，整条链一次入队，分片之间不会插入其他帧
+    const std::shared_ptr<SendNode> &GetNext() const { return this->_next; }
+    void SetNext(std::shared_ptr<SendNode> next) { this->_next = std::move(next); }
+    std::shared_ptr<SendNode> TakeNext() { return std::move(this->_next); }
+    // 是否带 HEADER_FLAG_MORE（同一消息后面还有分片）
+    bool HasMore() const { return this->_more; }
+
+    // 优先级：控制消息进入会话的控制发送队列，先于普通消息写出
+    MSG_PRIORITY GetPriority() const { return this->_priority; }
+    void SetPriority(MSG_PRIORITY priority) { this->_priority = priority; }
+
+private:
+    // 设置 Header，并转为网络字节序
+    void SetHeader(const MessageHeader &header);
+
+    // 消息头（网络字节序）
+    MessageHeader _header;
+    // 实际发送的消息头（指向 _header 或共享帧内的 Header）
+    const void *_headerData = &_header;
+    // 自有消息体（移动而来）
+    std::string _ownedBody;
+    // 外部消息体的持有者
+    std::shared_ptr<const void> _holder;
+    // 消息体数据及长度
+    const char *_bodyData;
+    uint32_t _bodyLen;
+    // 逻辑消息的键（本地字节序）
+    uint64_t _key = 0;
+    // 主动推送标志
+    bool _push = false;
+    // 分片标志
+    bool _more = false;
+    // 优先级
+    MSG_PRIORITY _priority = PRIORITY_BULK;
+    // 同一消息的下一个分片
+    std::shared_ptr<SendNode> _next;
+};
+
+#endif // SENDNODE_H
@@ -0,0 +1,47 @@
+#include "SharedFrame.h"
+
+#include <cstring>
+
+std::shared_ptr<const SharedFrame> SharedFrame::Create(const MessageHeader &header, std::string_view body)
+{
+    return std::allocate_shared<SharedFrame>(PoolAllocator<SharedFrame>(), header, body);
+}
+
+std::vector<std::shared_ptr<const SharedFrame>> SharedFrame::CreateChunks(const MessageHeader &header, std::string_view body, std::size_t maxFrameSize)
+{
+    std::vector<std::shared_ptr<const SharedFrame>> frames;
+
+    // 未超过单帧上限（含空消息体），整体作为一帧
+    if (body.size() <= maxFrameSize || maxFrameSize == 0)
+    {
+        MessageHeader frameHdr = header;
+        frameHdr.SetFlag(HEADER_FLAG_MORE, false);
+        frames.push_back(Create(frameHdr, body));
+        return frames;
+    }
+
+    frames.reserve((body.size() + maxFrameSize - 1) / maxFrameSize);
+    for (std::size_t offset = 0; offset < body.size(); offset += maxFrameSize)
+    {
+        auto chunk = body.substr(offset, maxFrameSize);
+        MessageHeader chunkHdr = header;
+        chunkHdr.SetFlag(HEADER_FLAG_MORE, offset + chunk.size() < body.size());
+        frames.push_back(Create(chunkHdr, chunk));
+    }
+    return frames;
+}
+
+SharedFrame::SharedFrame(const MessageHeader &header, std::string_view body)
+    : _buffer(sizeof(MessageHeader) + body.size())
+{
+    // Header 以实际消息体长度为准，并转为网络字节序（只做一次）
+    MessageHeader netHeader = header;
+    netHeader.length = static_cast<uint32_t>(body.size());
+    netHeader.ToNetwork();
+
+    std::memcpy(this->_buffer.data(), &netHeader, sizeof(MessageHeader));
+    if (!body.empty())
+    {
+        std::memcpy(this->_buffer.data() + sizeof(MessageHeader), body.data(), body.size());
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef SHAREDFRAME_H
+#define SHAREDFRAME_H
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "../protocol/MessageHeader.h"
+#include "BufferPool.h"
+
+// 共享帧
+// Header（网络字节序）+ Body 一次编码到连续内存，构造后只读，可同时挂入多个会话的发送队列，
+// 广播时每个接收方只增加一次引用计数，不再逐个拷贝消息体
+class SharedFrame
+{
+public:
+    // 工厂方法：拷贝一次消息体（对象本身与缓冲区均来自内存池）
+    static std::shared_ptr<const SharedFrame> Create(const MessageHeader &header, std::string_view body);
+    // 工厂方法：消息体超过单帧上限时切分为多个共享帧，除最后一个外均带 HEADER_FLAG_MORE
+    static std::vector<std::shared_ptr<const SharedFrame>> CreateChunks(const MessageHeader &header, std::string_view body, std::size_t maxFrameSize);
+
+    // 构造函数（请使用工厂方法）
+    SharedFrame(const MessageHeader &header, std::string_view body);
+
+    // 删除拷贝构造函数
+    SharedFrame(const SharedFrame &) = delete;
+    // 删除赋值构造函数
+    SharedFrame &operator=(const SharedFrame &) = delete;
+
+    // 获取 Header（网络字节序）
+    const char *GetHeaderData() const { return this->_buffer.data(); }
+    // 获取消息体
+    const char *GetBody() const { return this->_buffer.data() + sizeof(MessageHeader); }
+    uint32_t GetBodyLen() const { return static_cast<uint32_t>(this->_buffer.size() - sizeof(MessageHeader)); }
+    // 获取整帧字节数
+    std::size_t GetSize() const { return this->_buffer.size(); }
+
+private:
+    // Header + Body
+    PooledBuffer _buffer;
+};
+
+#endif // SHAREDFRAME_H
@@ -0,0 +1,47 @@
+#ifndef BODYCODEC_H
+#define BODYCODEC_H
+
+#include <string>
+#include <cstddef>
+#include "MessageHeader.h"
+#include "../message/MsgNode.h"
+#include "../../infra/util/json.hpp"
+
+// 消息体编解码器
+// 根据帧头的 HEADER_FLAG_BINARY 标志，在 JSON 文本与紧凑二进制（MessagePack）之间选择
+// 服务层统一通过 Decode 读取请求、通过 CSession::Send(header, json) 回包，无需关心具体编码
+class BodyCodec
+{
+public:
+    // 按帧标志解码消息体，格式错误时抛出 nlohmann::json::exception
+    static nlohmann::json Decode(const MessageHeader &header, const char *data, std::size_t len)
+    {
+        if (header.HasFlag(HEADER_FLAG_BINARY))
+        {
+            return nlohmann::json::from_msgpack(reinterpret_cast<const uint8_t *>(data),
+                                                reinterpret_cast<const uint8_t *>(data) + len);
+        }
+        // 直接解析原始内存，无需先拷贝为 std::string
+        return nlohmann::json::parse(data, data + len);
+    }
+
+    // 解码消息节点的消息体
+    static nlohmann::json Decode(const MsgNode &msg)
+    {
+        return Decode(msg.GetHeader(), msg.GetBody(), msg.GetBodyLen());
+    }
+
+    // 按帧标志编码消息体（JSON 输出紧凑格式，不缩进）
+    static std::string Encode(const MessageHeader &header, const nlohmann::json &body)
+    {
+        if (header.HasFlag(HEADER_FLAG_BINARY))
+        {
+            std::string out;
+            nlohmann::json::to_msgpack(body, out);
+            return out;
+        }
+        return body.dump();
+    }
+};
+
+#endif // BODYCODEC_H
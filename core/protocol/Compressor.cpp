@@ -0,0 +1,51 @@
+#include "Compressor.h"
+
+#include <cstring>
+#include <zlib.h>
+#include <boost/asio.hpp>
+
+bool Compressor::Compress(const char *data, std::size_t len, int level, std::string &out)
+{
+    // 预留最坏情况的空间
+    uLongf destLen = compressBound(static_cast<uLong>(len));
+    out.resize(PREFIX_SIZE + destLen);
+
+    // 写入原始长度
+    uint32_t originalLen = boost::asio::detail::socket_ops::host_to_network_long(static_cast<uint32_t>(len));
+    std::memcpy(out.data(), &originalLen, PREFIX_SIZE);
+
+    // 压缩
+    int ret = compress2(reinterpret_cast<Bytef *>(out.data() + PREFIX_SIZE), &destLen,
+                        reinterpret_cast<const Bytef *>(data), static_cast<uLong>(len), level);
+    if (ret != Z_OK || PREFIX_SIZE + destLen >= len)
+    {
+        out.clear();
+        return false;
+    }
+
+    out.resize(PREFIX_SIZE + destLen);
+    return true;
+}
+
+std::optional<uint32_t> Compressor::GetOriginalSize(const char *data, std::size_t len)
+{
+    if (len < PREFIX_SIZE)
+        return std::nullopt;
+
+    uint32_t originalLen = 0;
+    std::memcpy(&originalLen, data, PREFIX_SIZE);
+    return boost::asio::detail::socket_ops::network_to_host_long(originalLen);
+}
+
+bool Compressor::Decompress(const char *data, std::size_t len, char *dst, uint32_t dstLen)
+{
+    if (len < PREFIX_SIZE)
+        return false;
+
+    uLongf destLen = dstLen;
+    int ret = uncompress(reinterpret_cast<Bytef *>(dst), &destLen,
+                         reinterpret_cast<const Bytef *>(data + PREFIX_SIZE), static_cast<uLong>(len - PREFIX_SIZE));
+
+    // 解压后的长度必须与记录的原始长度一致
+    return ret == Z_OK && destLen == dstLen;
+}
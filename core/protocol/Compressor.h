@@ -0,0 +1,28 @@
+#ifndef COMPRESSOR_H
+#define COMPRESSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+// 消息体压缩（zlib）
+// 压缩后的格式：4 字节原始长度（网络字节序） + zlib 数据
+class Compressor
+{
+public:
+    // 压缩，压缩后没有变小时返回 false（此时应按原样发送）
+    static bool Compress(const char *data, std::size_t len, int level, std::string &out);
+
+    // 读取压缩数据中记录的原始长度，格式错误时返回空
+    static std::optional<uint32_t> GetOriginalSize(const char *data, std::size_t len);
+
+    // 解压至 dst，dstLen 必须等于原始长度
+    static bool Decompress(const char *data, std::size_t len, char *dst, uint32_t dstLen);
+
+private:
+    // 原始长度前缀的字节数
+    static constexpr std::size_t PREFIX_SIZE = sizeof(uint32_t);
+};
+
+#endif // COMPRESSOR_H
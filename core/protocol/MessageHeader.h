@@ -5,6 +5,13 @@
 #include <stdint.h>
 #include <boost/asio.hpp>
 
+// version 字段：低 8 位为协议版本号，高 8 位为帧标志位
+constexpr uint16_t HEADER_VERSION_MASK = 0x00FF;
+constexpr uint16_t HEADER_FLAG_BINARY = 0x0100;         // 消息体为紧凑二进制编码（MessagePack），否则为 JSON 文本
+constexpr uint16_t HEADER_FLAG_COMPRESSED = 0x0200;     // 消息体经过压缩（4 字节原始长度 + zlib 数据）
+constexpr uint16_t HEADER_FLAG_ACCEPT_COMPRESS = 0x0400; // 客户端可接收压缩后的响应
+constexpr uint16_t HEADER_FLAG_MORE = 0x0800;            // 分片传输：后续还有同一 (serviceId, cmdId, seq) 的分片（最后一片不带此标志）
+
 // MessageHeader 定义（带1字节对齐）
 #pragma pack(push, 1)
 struct MessageHeader
@@ -16,6 +23,25 @@ struct MessageHeader
     uint32_t length;    // Body 长度（仅消息体，不含Header）
     uint32_t seq;       // 请求序号
 
+    // 获取协议版本号（不含标志位）
+    uint16_t GetVersion() const { return version & HEADER_VERSION_MASK; }
+    // 获取全部标志位
+    uint16_t GetFlags() const { return version & ~HEADER_VERSION_MASK; }
+    // 是否设置了某个标志位
+    bool HasFlag(uint16_t flag) const { return (version & flag) != 0; }
+    // 设置或清除某个标志位
+    void SetFlag(uint16_t flag, bool enable)
+    {
+        version = enable ? (version | flag) : (version & ~flag);
+    }
+
+    // 逻辑消息的键 serviceId << 48 | cmdId << 32 | seq（本地字节序），同一消息的各分片相同
+    // 客户端可能复用 seq，分片重组与流式命令的按序队列均以此区分不同的消息
+    uint64_t GetMessageKey() const
+    {
+        return (static_cast<uint64_t>(serviceId) << 48) | (static_cast<uint64_t>(cmdId) << 32) | seq;
+    }
+
     // 转为网络字节序
     void ToNetwork()
     {
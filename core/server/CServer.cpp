@@ -8,31 +8,56 @@
 #include "../../net/threaded/AsyncSession.h"
 
 #include "../../infra/log/Logger.h"
+#include "../../infra/metrics/Metrics.h"
+#include "../../config/ConfigManager.h"
+
+#include <algorithm>
 
 CServer::CServer(boost::asio::io_context &ioc, const uint16_t port, ASIO_TYPE type)
-    : _port(port),
-      _ioContext(ioc),
-      _acceptor(ioc, boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), port)),
-      _type(type),
-      _isFirstCreate(true)
+    : _ioContext(ioc),
+      _port(port),
+      _reusePort(ConfigManager::GetInstance().IsReusePortEnabled()),
+      _socketProfile(ConfigManager::GetInstance().GetSocketProfile()),
+      _type(type)
 {
     LOG_INFO << "Server Start in " << port << std::endl;
-    // 启动连接
-    switch (this->_type)
+    LOG_INFO << "Session type: " << (this->_type == ASIO_TYPE::ASYNC ? "async" : "coroutine") << std::endl;
+
+#ifndef SO_REUSEPORT
+    if (this->_reusePort)
     {
-    case ASIO_TYPE::ASYNC:
-        StartAsyncAccpet();
-        break;
-    case ASIO_TYPE::COROUTINE:
-        StartCoroutineAccpet();
-        break;
-    // 默认使用协程模式
-    default:
-        StartCoroutineAccpet();
-        break;
+        LOG_WARN << "SO_REUSEPORT is not supported on this platform, use a single acceptor" << std::endl;
+        this->_reusePort = false;
+    }
+#endif
+
+    if (this->_reusePort)
+    {
+        // 每个 io_context 一个监听器（启用网卡节点引导时仅限网卡所在节点的上下文）
+        auto &pool = AsioIOServicePool::GetInstance();
+        for (auto index : pool.GetAcceptIndices())
+        {
+            this->_listeners.push_back(std::make_unique<Listener>(pool.GetIOService(index)));
+        }
+        LOG_INFO << "SO_REUSEPORT enabled, acceptors: " << this->_listeners.size() << std::endl;
+    }
+    else
+    {
+        this->_listeners.push_back(std::make_unique<Listener>(ioc));
     }
 
-    this->_isFirstCreate = false;
+    // 启动连接
+    for (auto &listener : this->_listeners)
+    {
+        OpenListener(*listener, this->_reusePort);
+    }
+    this->_socketProfile.LogEffective(this->_listeners.front()->acceptor);
+    for (auto &listener : this->_listeners)
+    {
+        // 在监听器所在的上下文中发起，保证监听器只在一个线程中访问
+        boost::asio::post(listener->ioc, [this, pListener = listener.get()]()
+                          { StartAccept(*pListener); });
+    }
 }
 
 CServer::~CServer()
@@ -41,114 +66,135 @@ CServer::~CServer()
     ClearSession();
 }
 
+void CServer::Stop()
+{
+    for (auto &listener : this->_listeners)
+    {
+        // 在监听器所在的上下文中关闭，取消挂起的接收与退避定时器
+        boost::asio::post(listener->ioc, [pListener = listener.get()]()
+                          {
+                              boost::system::error_code ec;
+                              pListener->backoffTimer.cancel();
+                              pListener->acceptor.close(ec); });
+    }
+}
+
 void CServer::ClearSession()
 {
-    this->_sessionMap.clear();
+    this->_sessions.Clear();
+}
+
+void CServer::DelSessionById(SessionId id)
+{
+    this->_sessions.Remove(id);
 }
 
-void CServer::DelSessionByUuid(const std::string &uuid)
+std::shared_ptr<CSession> CServer::GetSessionById(SessionId id)
 {
-    std::lock_guard<std::mutex> lock(this->_mutex);
-    this->_sessionMap.erase(uuid);
+    return this->_sessions.Find(id);
 }
 
-std::shared_ptr<CSession> CServer::GetSessionByUuid(const std::string &uuid)
+void CServer::ForEachSession(const std::function<void(const std::shared_ptr<CSession> &)> &func) const
 {
-    // 加锁
-    std::lock_guard<std::mutex> lock(this->_mutex);
-    // 查找
-    auto it = this->_sessionMap.find(uuid);
-    if (it != this->_sessionMap.end())
+    this->_sessions.ForEach(func);
+}
+
+std::size_t CServer::GetSessionCount() const
+{
+    return this->_sessions.Size();
+}
+
+void CServer::OpenListener(Listener &listener, bool reusePort)
+{
+    boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), this->_port);
+    listener.acceptor.open(endpoint.protocol());
+    listener.acceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+#ifdef SO_REUSEPORT
+    if (reusePort)
     {
-        return it->second;
+        listener.acceptor.set_option(boost::asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>(true));
     }
-    return nullptr;
+#endif
+    // 缓冲区大小需在 listen 之前设置，新连接继承
+    this->_socketProfile.ApplyListener(listener.acceptor);
+    listener.acceptor.bind(endpoint);
+    listener.acceptor.listen(this->_socketProfile.backlog > 0 ? this->_socketProfile.backlog
+                                                              : boost::asio::socket_base::max_listen_connections);
 }
 
-void CServer::StartCoroutineAccpet()
+std::shared_ptr<CSession> CServer::CreateSession(boost::asio::io_context &ioc, boost::asio::ip::tcp::socket socket)
 {
-    if (this->_isFirstCreate)
-        LOG_INFO << "StartCoroutineAccpet " << std::endl;
-    // 从会话池中获取一个新会话
-    auto &ioc = AsioIOServicePool::GetInstance().GetIOServive();
+    switch (this->_type)
+    {
+    case ASIO_TYPE::ASYNC:
+        return std::make_shared<AsyncSession>(ioc, std::move(socket), this);
+    case ASIO_TYPE::COROUTINE:
+        return std::make_shared<CoroutineSession>(ioc, std::move(socket), this);
+    // 默认使用协程模式
+    default:
+        return std::make_shared<CoroutineSession>(ioc, std::move(socket), this);
+    }
+}
+
+void CServer::StartAccept(Listener &listener)
+{
+    // 会话所在的上下文：SO_REUSEPORT 模式下即监听器所在的上下文，否则从线程池中轮询获取
+    auto &ioc = this->_reusePort ? listener.ioc : AsioIOServicePool::GetInstance().GetAcceptIOService();
     // 获取指针，用于 lambda 安全捕获
     boost::asio::io_context *pIoc = &ioc;
 
     // 创建轻量级 socket
     auto socket = std::make_shared<boost::asio::ip::tcp::socket>(ioc);
     // 开始异步监听
-    this->_acceptor.async_accept(*socket,
-                                 [this, socket, pIoc](const boost::system::error_code &error)
-                                 {
-                                     if (!error)
-                                     {
-                                         // 2. 构造 Session，使用 *pIoc 安全地访问上下文
-                                         // 注意：这里需要解引用 socket 指针并 move
-                                         std::shared_ptr<CSession> newSession = std::make_shared<CoroutineSession>(*pIoc, std::move(*socket), this);
-
-                                         newSession->Start();
-                                         // 输出日志信息
-                                         LOG_INFO << "Get Connention From " << newSession->GetSocket().remote_endpoint() << std::endl;
-                                         {
-                                             std::lock_guard<std::mutex> lock(this->_mutex);
-                                             this->_sessionMap.insert(std::make_pair(newSession->GetUuid(), newSession));
-                                         }
-                                     }
-                                     else
-                                     {
-                                         LOG_WARN << "Accept Error: " << error.message() << std::endl;
-                                         // 特殊处理文件描述符耗尽的情况
-                                         if (error == boost::asio::error::no_descriptors)
-                                         {
-                                             // 休眠 100ms 再重试，避免 CPU 空转
-                                             std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                                         }
-                                     }
-
-                                     StartCoroutineAccpet();
-                                 });
+    listener.acceptor.async_accept(*socket,
+                                   [this, socket, pIoc, &listener](const boost::system::error_code &error)
+                                   {
+                                       if (!error)
+                                       {
+                                           listener.backoff = std::chrono::milliseconds(0);
+                                           Metrics::GetInstance().RecordAccept();
+                                           this->_socketProfile.ApplyAccepted(*socket);
+
+                                           // 构造 Session，使用 *pIoc 安全地访问上下文
+                                           // 注意：这里需要解引用 socket 指针并 move
+                                           std::shared_ptr<CSession> newSession = CreateSession(*pIoc, std::move(*socket));
+
+                                           newSession->Start();
+                                           // 输出日志信息
+                                           boost::system::error_code ec;
+                                           LOG_INFO << "Get Connention From " << newSession->GetSocket().remote_endpoint(ec) << std::endl;
+                                           this->_sessions.Add(newSession);
+                                       }
+                                       else
+                                       {
+                                           // 监听器已关闭，停止监听
+                                           if (error == boost::asio::error::operation_aborted || !listener.acceptor.is_open())
+                                               return;
+
+                                           LOG_WARN << "Accept Error: " << error.message() << std::endl;
+                                           // 特殊处理文件描述符耗尽的情况：定时退避后重试，避免 CPU 空转，也不阻塞线程
+                                           if (error == boost::asio::error::no_descriptors ||
+                                               error == boost::system::errc::too_many_files_open_in_system)
+                                           {
+                                               BackoffAccept(listener);
+                                               return;
+                                           }
+                                       }
+
+                                       StartAccept(listener);
+                                   });
 }
 
-void CServer::StartAsyncAccpet()
+void CServer::BackoffAccept(Listener &listener)
 {
-    if (this->_isFirstCreate)
-        LOG_INFO << "StartAsyncAccpet " << std::endl;
-    // 从会话池中获取一个新会话
-    auto &ioc = AsioIOServicePool::GetInstance().GetIOServive();
-    // 获取指针，用于 lambda 安全捕获
-    boost::asio::io_context *pIoc = &ioc;
+    // 退避时长从 10ms 开始翻倍，最长 1s
+    listener.backoff = std::clamp(listener.backoff * 2, std::chrono::milliseconds(10), std::chrono::milliseconds(1000));
+    Metrics::GetInstance().RecordAcceptBackoff();
 
-    // 创建轻量级 socket
-    auto socket = std::make_shared<boost::asio::ip::tcp::socket>(ioc);
-    // 开始异步监听
-    this->_acceptor.async_accept(*socket,
-                                 [this, socket, pIoc](const boost::system::error_code &error)
-                                 {
-                                     if (!error)
-                                     {
-                                         // 2. 构造 Session，使用 *pIoc 安全地访问上下文
-                                         // 注意：这里需要解引用 socket 指针并 move
-                                         std::shared_ptr<CSession> newSession = std::make_shared<AsyncSession>(*pIoc, std::move(*socket), this);
-
-                                         newSession->Start();
-                                         // 输出日志信息
-                                         LOG_INFO << "Get Connention From " << newSession->GetSocket().remote_endpoint() << std::endl;
-                                         {
-                                             std::lock_guard<std::mutex> lock(this->_mutex);
-                                             this->_sessionMap.insert(std::make_pair(newSession->GetUuid(), newSession));
-                                         }
-                                     }
-                                     else
+    listener.backoffTimer.expires_after(listener.backoff);
+    listener.backoffTimer.async_wait([this, &listener](const boost::system::error_code &error)
                                      {
-                                         LOG_WARN << "Accept Error: " << error.message() << std::endl;
-                                         // 特殊处理文件描述符耗尽的情况
-                                         if (error == boost::asio::error::no_descriptors)
-                                         {
-                                             // 休眠 100ms 再重试，避免 CPU 空转
-                                             std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                                         }
-                                     }
-
-                                     StartAsyncAccpet();
-                                 });
-}
\ No newline at end of file
+                                         if (error || !listener.acceptor.is_open())
+                                             return;
+                                         StartAccept(listener); });
+}
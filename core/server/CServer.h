@@ -5,11 +5,15 @@
 #include <iostream>
 #include <string>
 #include <memory>
-#include <mutex>
-#include <unordered_map>
+#include <chrono>
+#include <vector>
+#include <functional>
 #include <boost/asio.hpp>
 
 #include "../common/Const.h"
+#include "../session/SessionId.h"
+#include "SessionRegistry.h"
+#include "SocketProfile.h"
 
 // 前置声明
 class CSession;
@@ -24,40 +28,61 @@ public:
     ~CServer();
 
     // 对外接口
+    // 停止监听（关闭所有监听器，使各 io_context 可以退出）
+    void Stop();
     // 清空所有会话
     void ClearSession();
-    // 删除 uuid 对应的 Session
-    void DelSessionByUuid(const std::string &);
-    // 获取 uuid 对应的 Session
-    std::shared_ptr<CSession> GetSessionByUuid(const std::string &);
+    // 删除 id 对应的 Session
+    void DelSessionById(SessionId id);
+    // 获取 id 对应的 Session
+    std::shared_ptr<CSession> GetSessionById(SessionId id);
+    // 遍历所有会话（用于广播、关闭等批量操作）
+    void ForEachSession(const std::function<void(const std::shared_ptr<CSession> &)> &func) const;
+    // 当前会话数量
+    std::size_t GetSessionCount() const;
 
 private:
+    // 监听器
+    struct Listener
+    {
+        Listener(boost::asio::io_context &ioc)
+            : ioc(ioc), acceptor(ioc), backoffTimer(ioc), backoff(0) {}
+
+        // 监听器所在的上下文（SO_REUSEPORT 模式下新会话也运行在此上下文）
+        boost::asio::io_context &ioc;
+        // tcp服务器监听器
+        boost::asio::ip::tcp::acceptor acceptor;
+        // 文件描述符耗尽时的退避定时器
+        boost::asio::steady_timer backoffTimer;
+        // 当前退避时长，接收成功后清零
+        std::chrono::milliseconds backoff;
+    };
+
+    // 打开监听器：reusePort 为 true 时设置 SO_REUSEPORT，多个监听器绑定同一端口，由内核分配连接
+    void OpenListener(Listener &listener, bool reusePort);
     // 开始监听
-    // 协程方式
-    void StartCoroutineAccpet();
-    // 异步方式
-    void StartAsyncAccpet();
-    // 处理接收操作
-    // void HandleAccpet(std::shared_ptr<CSession>, const boost::system::error_code &error);
-    // 辅助启动方法
-    // void AssistStart(bool isCreateFunc = false);
+    void StartAccept(Listener &listener);
+    // 接收失败（文件描述符耗尽）时按指数退避，定时器到期后再继续监听，不阻塞线程
+    void BackoffAccept(Listener &listener);
+    // 按服务类型创建会话
+    std::shared_ptr<CSession> CreateSession(boost::asio::io_context &ioc, boost::asio::ip::tcp::socket socket);
 
     // 私有属性
     // 上下文
     boost::asio::io_context &_ioContext;
     // 端口号
     uint16_t _port;
-    // tcp服务器监听器
-    boost::asio::ip::tcp::acceptor _acceptor;
-    // 会话管理字典
-    std::unordered_map<std::string, std::shared_ptr<CSession>> _sessionMap;
-    // 信号量
-    std::mutex _mutex;
+    // 监听器：默认只有一个（运行在主上下文，会话轮询分配至线程池）；
+    // SO_REUSEPORT 模式下线程池中每个上下文各一个
+    std::vector<std::unique_ptr<Listener>> _listeners;
+    // 是否为 SO_REUSEPORT 模式
+    bool _reusePort;
+    // 监听器及新连接的套接字参数
+    SocketProfile _socketProfile;
+    // 会话注册表（分片加锁）
+    SessionRegistry _sessions;
     // 服务类型
     ASIO_TYPE _type;
-
-    // 是否为第一次创建
-    bool _isFirstCreate = true;
 };
 
 #endif // CSERVER_H
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "SessionRegistry.h"
+
+#include <thread>
+#include <vector>
+
+#include "../session/CSession.h"
+
+namespace
+{
+    // 风险指针数量上限（每个执行过查找的线程占用一个，线程退出时归还）
+    constexpr std::size_t HAZARD_COUNT = 256;
+
+    // 风险指针（独占缓存行，查找只写本线程的槽位）
+    struct alignas(64) HazardSlot
+    {
+        // 正在引用的会话
+        std::atomic<const CSession *> ptr{nullptr};
+        // 是否已被线程占用
+        std::atomic<bool> used{false};
+    };
+
+    HazardSlot g_hazards[HAZARD_COUNT];
+    // 曾被占用过的最大槽位数，删除方只扫描此范围
+    std::atomic<std::size_t> g_hazardHigh{0};
+
+    // 线程持有的风险指针：首次查找时占用，线程退出时归还
+    struct HazardOwner
+    {
+        HazardOwner()
+        {
+            for (std::size_t i = 0; i < HAZARD_COUNT; i++)
+            {
+                bool expected = false;
+                if (g_hazards[i].used.compare_exchange_strong(expected, true))
+                {
+                    this->slot = &g_hazards[i];
+                    // 更新扫描范围
+                    std::size_t high = g_hazardHigh.load();
+                    while (high < i + 1 && !g_hazardHigh.compare_exchange_weak(high, i + 1))
+                    {
+                    }
+                    break;
+                }
+            }
+        }
+
+        ~HazardOwner()
+        {
+            if (this->slot)
+            {
+                this->slot->ptr.store(nullptr);
+                this->slot->used.store(false);
+            }
+        }
+
+        // 删除拷贝构造函数
+        HazardOwner(const HazardOwner &) = delete;
+        // 删除赋值构造函数
+        HazardOwner &operator=(const HazardOwner &) = delete;
+
+        // 占用的槽位，全部被占用时为 nullptr
+        HazardSlot *slot = nullptr;
+    };
+
+    thread_local HazardOwner t_hazard;
+
+    // 等待所有读取方不再引用该会话（读取方只在取得引用计数的瞬间持有风险指针，等待极短）
+    void WaitForReaders(const CSession *session)
+    {
+        std::size_t high = g_hazardHigh.load();
+        for (std::size_t i = 0; i < high; i++)
+        {
+            while (g_hazards[i].ptr.load() == session)
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+SessionRegistry::~SessionRegistry()
+{
+    Clear();
+    for (auto &page : this->_pages)
+    {
+        delete page.load();
+    }
+}
+
+std::atomic<CSession *> *SessionRegistry::GetEntry(SessionId id, bool create) const
+{
+    auto slot = SessionIdAllocator::GetSlot(id);
+    auto index = slot / PAGE_SIZE;
+    if (index >= MAX_PAGES)
+        return nullptr;
+
+    auto page = this->_pages[index].load(std::memory_order_acquire);
+    if (page == nullptr)
+    {
+        if (!create)
+            return nullptr;
+
+        // 不同分片的写入方可能同时创建同一页，未能发布的一方释放自己创建的页
+        auto created = new Page();
+        if (this->_pages[index].compare_exchange_strong(page, created, std::memory_order_acq_rel))
+        {
+            page = created;
+        }
+        else
+        {
+            delete created;
+        }
+    }
+    return &page->sessions[slot % PAGE_SIZE];
+}
+
+void SessionRegistry::Add(const std::shared_ptr<CSession> &session)
+{
+    auto id = session->GetId();
+    auto &shard = GetShard(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.sessions.insert(std::make_pair(id, session));
+
+    // 发布至会话指针表（分片持有所有权，表中只存放指针）
+    if (auto entry = GetEntry(id, true))
+    {
+        entry->store(session.get());
+    }
+}
+
+void SessionRegistry::Remove(SessionId id)
+{
+    // 在锁外释放会话，避免析构在持锁期间执行
+    std::shared_ptr<CSession> removed;
+    {
+        auto &shard = GetShard(id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.sessions.find(id);
+        if (it == shard.sessions.end())
+            return;
+        removed = std::move(it->second);
+        shard.sessions.erase(it);
+        Unpublish(removed);
+    }
+    // 在锁外等待读取方，不阻塞同一分片的其他写入方
+    WaitForReaders(removed.get());
+}
+
+void SessionRegistry::Unpublish(const std::shared_ptr<CSession> &session)
+{
+    auto entry = GetEntry(session->GetId(), false);
+    if (entry == nullptr)
+        return;
+
+    // 摘除后新的读取方不再能读到该指针，已经读到的读取方由调用方在锁外等待
+    CSession *expected = session.get();
+    entry->compare_exchange_strong(expected, nullptr);
+}
+
+std::shared_ptr<CSession> SessionRegistry::Find(SessionId id) const
+{
+    // 本线程没有可用的风险指针，或槽位超出会话指针表上限
+    auto hazard = t_hazard.slot;
+    if (hazard == nullptr || SessionIdAllocator::GetSlot(id) / PAGE_SIZE >= MAX_PAGES)
+        return FindLocked(id);
+
+    auto entry = GetEntry(id, false);
+    if (entry == nullptr)
+        return nullptr;
+
+    // 读取指针 -> 登记风险指针 -> 再次确认仍在表中：此后删除方会等待本线程清除风险指针，会话不会被释放
+    CSession *session = entry->load();
+    for (;;)
+    {
+        if (session == nullptr)
+            return nullptr;
+        hazard->ptr.store(session);
+        CSession *current = entry->load();
+        if (current == session)
+            break;
+        session = current;
+    }
+
+    // 槽位已被新会话复用时代数不同
+    std::shared_ptr<CSession> result;
+    if (session->GetId() == id)
+    {
+        result = session->shared_from_this();
+    }
+    hazard->ptr.store(nullptr, std::memory_order_release);
+    return result;
+}
+
+std::shared_ptr<CSession> SessionRegistry::FindLocked(SessionId id) const
+{
+    auto &shard = GetShard(id);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.sessions.find(id);
+    if (it != shard.sessions.end())
+    {
+        return it->second;
+    }
+    return nullptr;
+}
+
+void SessionRegistry::Clear()
+{
+    for (auto &shard : this->_shards)
+    {
+        std::unordered_map<SessionId, std::shared_ptr<CSession>> sessions;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            sessions.swap(shard.sessions);
+            for (auto &item : sessions)
+            {
+                Unpublish(item.second);
+            }
+        }
+        for (auto &item : sessions)
+        {
+            WaitForReaders(item.second.get());
+        }
+    }
+}
+
+void SessionRegistry::ForEach(const std::function<void(const std::shared_ptr<CSession> &)> &func) const
+{
+    std::vector<std::shared_ptr<CSession>> snapshot;
+    for (auto &shard : this->_shards)
+    {
+        snapshot.clear();
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            snapshot.reserve(shard.sessions.size());
+            for (auto &item : shard.sessions)
+            {
+                snapshot.push_back(item.second);
+            }
+        }
+
+        for (auto &session : snapshot)
+        {
+            func(session);
+        }
+    }
+}
+
+std::size_t SessionRegistry::Size() const
+{
+    std::size_t size = 0;
+    for (auto &shard : this->_shards)
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        size += shard.sessions.size();
+    }
+    return size;
+}
@@ -0,0 +1,79 @@
+#ifndef SESSIONREGISTRY_H
+#define SESSIONREGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "../session/SessionId.h"
+
+// 前置声明
+class CSession;
+
+// 分片会话注册表
+// 写入：按会话槽位分散到固定数量的分片，接入 / 断开只锁定所在分片，分片持有会话的所有权
+// 读取：按槽位直接下标访问会话指针表，不加锁、不修改共享数据（无锁读）
+//      读取方以线程独占的风险指针（hazard pointer）保护读到的会话，删除方等待没有读取方引用该会话后再释放
+class SessionRegistry
+{
+public:
+    // 分片数量（2 的幂）
+    static constexpr std::size_t SHARD_COUNT = 16;
+    // 会话指针表：每页槽位数及页数上限（超出上限的槽位退回为加锁查找）
+    static constexpr std::size_t PAGE_SIZE = 1024;
+    static constexpr std::size_t MAX_PAGES = 1024;
+
+    SessionRegistry() = default;
+    ~SessionRegistry();
+    // 删除拷贝构造函数
+    SessionRegistry(const SessionRegistry &) = delete;
+    // 删除赋值构造函数
+    SessionRegistry &operator=(const SessionRegistry &) = delete;
+
+    // 添加会话
+    void Add(const std::shared_ptr<CSession> &session);
+    // 删除会话（会话在锁外、且没有读取方引用后释放）
+    void Remove(SessionId id);
+    // 查找会话，不存在时返回 nullptr（无锁，任意线程）
+    std::shared_ptr<CSession> Find(SessionId id) const;
+    // 遍历所有会话（逐个分片拷贝快照后在锁外回调，回调中可安全增删会话）
+    void ForEach(const std::function<void(const std::shared_ptr<CSession> &)> &func) const;
+    // 清空所有会话
+    void Clear();
+    // 当前会话数量
+    std::size_t Size() const;
+
+private:
+    // 分片（独占缓存行，避免相邻分片的锁伪共享）
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        std::unordered_map<SessionId, std::shared_ptr<CSession>> sessions;
+    };
+
+    // 会话指针表的一页 下标为槽位
+    struct Page
+    {
+        std::array<std::atomic<CSession *>, PAGE_SIZE> sessions{};
+    };
+
+    // 获取分片：槽位号连续分配，取低位即可均匀分布
+    Shard &GetShard(SessionId id) const { return this->_shards[SessionIdAllocator::GetSlot(id) & (SHARD_COUNT - 1)]; }
+    // 获取槽位在会话指针表中的位置，页不存在（且 create 为 false）或超出上限时返回 nullptr
+    std::atomic<CSession *> *GetEntry(SessionId id, bool create) const;
+    // 加锁查找（槽位超出会话指针表上限，或本线程没有可用的风险指针时）
+    std::shared_ptr<CSession> FindLocked(SessionId id) const;
+    // 从会话指针表中摘除会话（持分片锁调用），调用方释放锁后须等待读取方（WaitForReaders）再释放会话
+    void Unpublish(const std::shared_ptr<CSession> &session);
+
+    // 分片数组（查找的回退路径同样需要加锁，因此为 mutable）
+    mutable std::array<Shard, SHARD_COUNT> _shards;
+    // 会话指针表的页（按需创建，注册表析构时释放）
+    mutable std::array<std::atomic<Page *>, MAX_PAGES> _pages{};
+};
+
+#endif // SESSIONREGISTRY_H
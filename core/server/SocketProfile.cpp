@@ -0,0 +1,83 @@
+#include "SocketProfile.h"
+
+#include "../../infra/log/Logger.h"
+
+#ifndef _WIN32
+#include <netinet/tcp.h>
+#endif
+
+namespace
+{
+    // 整型 TCP 选项
+    template <int Name>
+    using TcpOption = boost::asio::detail::socket_option::integer<IPPROTO_TCP, Name>;
+
+    // 设置选项，失败时记录日志
+    template <typename Socket, typename Option>
+    void SetOption(Socket &socket, const Option &option, const char *name)
+    {
+        boost::system::error_code ec;
+        socket.set_option(option, ec);
+        if (ec)
+        {
+            LOG_WARN << "SocketProfile: set " << name << " failed: " << ec.message() << std::endl;
+        }
+    }
+}
+
+void SocketProfile::ApplyListener(boost::asio::ip::tcp::acceptor &acceptor) const
+{
+    if (this->recvBuffer > 0)
+        SetOption(acceptor, boost::asio::socket_base::receive_buffer_size(this->recvBuffer), "SO_RCVBUF");
+    if (this->sendBuffer > 0)
+        SetOption(acceptor, boost::asio::socket_base::send_buffer_size(this->sendBuffer), "SO_SNDBUF");
+}
+
+void SocketProfile::ApplyAccepted(boost::asio::ip::tcp::socket &socket) const
+{
+    SetOption(socket, boost::asio::ip::tcp::no_delay(this->noDelay), "TCP_NODELAY");
+
+    if (this->keepAlive)
+    {
+        SetOption(socket, boost::asio::socket_base::keep_alive(true), "SO_KEEPALIVE");
+#ifdef TCP_KEEPIDLE
+        if (this->keepAliveIdle > 0)
+            SetOption(socket, TcpOption<TCP_KEEPIDLE>(this->keepAliveIdle), "TCP_KEEPIDLE");
+#endif
+#ifdef TCP_KEEPINTVL
+        if (this->keepAliveInterval > 0)
+            SetOption(socket, TcpOption<TCP_KEEPINTVL>(this->keepAliveInterval), "TCP_KEEPINTVL");
+#endif
+#ifdef TCP_KEEPCNT
+        if (this->keepAliveCount > 0)
+            SetOption(socket, TcpOption<TCP_KEEPCNT>(this->keepAliveCount), "TCP_KEEPCNT");
+#endif
+    }
+
+#ifdef TCP_NOTSENT_LOWAT
+    if (this->notSentLowat > 0)
+        SetOption(socket, TcpOption<TCP_NOTSENT_LOWAT>(this->notSentLowat), "TCP_NOTSENT_LOWAT");
+#endif
+}
+
+void SocketProfile::LogEffective(boost::asio::ip::tcp::acceptor &acceptor) const
+{
+    boost::system::error_code ec;
+    boost::asio::socket_base::receive_buffer_size recvBuffer;
+    boost::asio::socket_base::send_buffer_size sendBuffer;
+    acceptor.get_option(recvBuffer, ec);
+    acceptor.get_option(sendBuffer, ec);
+
+    LOG_INFO << "SocketProfile: nodelay=" << this->noDelay
+             << ", keepalive=" << this->keepAlive
+             << " (idle=" << this->keepAliveIdle << "s, interval=" << this->keepAliveInterval << "s, count=" << this->keepAliveCount << ")"
+             << ", notsent_lowat=" << this->notSentLowat
+             << ", backlog=" << this->backlog << std::endl;
+    LOG_INFO << "SocketProfile: rcvbuf=" << this->recvBuffer << " (effective " << recvBuffer.value() << ")"
+             << ", sndbuf=" << this->sendBuffer << " (effective " << sendBuffer.value() << ")" << std::endl;
+
+#ifndef TCP_NOTSENT_LOWAT
+    if (this->notSentLowat > 0)
+        LOG_WARN << "SocketProfile: TCP_NOTSENT_LOWAT is not supported on this platform" << std::endl;
+#endif
+}
@@ -0,0 +1,35 @@
+#ifndef SOCKETPROFILE_H
+#define SOCKETPROFILE_H
+
+#include <cstdint>
+#include <boost/asio.hpp>
+
+// 套接字调优参数（对应 server.json 中的 socket 段）
+// 数值为 0 表示不设置，使用系统默认值
+struct SocketProfile
+{
+    // 禁用 Nagle 算法，小包请求/响应立即发出
+    bool noDelay = true;
+    // TCP 保活
+    bool keepAlive = true;
+    // 保活：空闲多久开始探测（秒）、探测间隔（秒）、探测次数
+    int keepAliveIdle = 60;
+    int keepAliveInterval = 10;
+    int keepAliveCount = 3;
+    // 接收 / 发送缓冲区大小（字节），在监听器上设置，由新连接继承（保证窗口扩大因子在握手时生效）
+    int recvBuffer = 0;
+    int sendBuffer = 0;
+    // 发送缓冲区中未发送数据的低水位（字节），限制内核中积压的数据量，降低排队延迟
+    int notSentLowat = 0;
+    // 监听队列长度（0 表示系统上限）
+    int backlog = 1024;
+
+    // 设置监听器参数（bind 之前调用）
+    void ApplyListener(boost::asio::ip::tcp::acceptor &acceptor) const;
+    // 设置新连接参数（接收成功后调用），设置失败只记录日志，不影响连接
+    void ApplyAccepted(boost::asio::ip::tcp::socket &socket) const;
+    // 输出配置值及监听器上实际生效的值（内核可能调整缓冲区大小）
+    void LogEffective(boost::asio::ip::tcp::acceptor &acceptor) const;
+};
+
+#endif // SOCKETPROFILE_H
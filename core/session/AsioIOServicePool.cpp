@@ -4,9 +4,8 @@
 #include "../../infra/log/Logger.h"
 
 #include "../../config/ConfigManager.h"
-
-#include <filesystem>
-#include <fstream>
+#include "../../infra/util/CpuTopology.h"
+#include "../message/BufferPool.h"
 
 // 私有构造函数
 AsioIOServicePool::AsioIOServicePool(std::size_t size)
@@ -16,17 +15,97 @@ AsioIOServicePool::AsioIOServicePool(std::size_t size)
       _works(size)
 {
     LOG_INFO << "IOService Count is " << size << std::endl;
+#if defined(BOOST_ASIO_HAS_IO_URING) && defined(BOOST_ASIO_DISABLE_EPOLL)
+    LOG_INFO << "IOService backend: io_uring" << std::endl;
+#else
+    LOG_INFO << "IOService backend: default" << std::endl;
+#endif
     // 赋值work，使得每个 work 管理各自的 iocontext
     for (size_t i = 0; i < size; i++)
     {
         this->_works[i] = std::make_unique<Work>(boost::asio::make_work_guard(this->_ioServices[i]));
     }
 
+    // 空闲检测时间轮（超时为 0 时不启用）
+    auto &config = ConfigManager::GetInstance();
+    if (config.GetIdleTimeout() > 0)
+    {
+        LOG_INFO << "Idle timeout is " << config.GetIdleTimeout() << "s, tick " << config.GetIdleTick() << "ms" << std::endl;
+        for (size_t i = 0; i < size; i++)
+        {
+            this->_idleWheels.push_back(std::make_unique<IdleWheel>(this->_ioServices[i],
+                                                                    std::chrono::milliseconds(config.GetIdleTick()),
+                                                                    std::chrono::seconds(config.GetIdleTimeout())));
+            this->_idleWheels.back()->Start();
+        }
+    }
+
+    // 请求分发调度器（最大同时执行数为 0 时不启用）
+    if (config.GetSchedulerMaxRunning() > 0)
+    {
+        LOG_INFO << "Dispatch scheduler max running is " << config.GetSchedulerMaxRunning() << std::endl;
+        for (size_t i = 0; i < size; i++)
+        {
+            this->_schedulers.push_back(std::make_unique<DispatchScheduler>(this->_ioServices[i], config.GetSchedulerMaxRunning()));
+        }
+    }
+
+    // 计算线程绑核与新连接的分配范围
+    InitPlacement();
+
     // 开启各自的线程
     for (size_t i = 0; i < size; i++)
     {
         this->_threads.emplace_back([this, i]()
-                                    { this->_ioServices[i].run(); });
+                                    {
+                                        // 先绑核再运行：此后本线程首次访问的内存（本地内存池、会话缓冲区）由所在节点分配
+                                        if (this->_cpus[i] >= 0 && !util::PinCurrentThread(this->_cpus[i]))
+                                        {
+                                            LOG_WARN << "IOService " << i << ": failed to pin to cpu " << this->_cpus[i] << std::endl;
+                                        }
+                                        BufferPool::SetThreadNode(this->_nodes[i]);
+                                        this->_ioServices[i].run(); });
+    }
+}
+
+void AsioIOServicePool::InitPlacement()
+{
+    auto &config = ConfigManager::GetInstance();
+
+    // 绑核：第 i 个线程绑定到列表中第 i 个 CPU（列表不足时循环使用）
+    std::vector<std::string> invalidCpus;
+    auto cpuList = util::ParseCpuList(config.GetAffinityCpus(), invalidCpus);
+    for (auto &item : invalidCpus)
+    {
+        LOG_WARN << "affinity/cpus: skip invalid entry \"" << item << "\" (valid cpu range is [0, " << util::GetCpuLimit() << "))" << std::endl;
+    }
+    this->_cpus.assign(this->_maxSize, -1);
+    this->_nodes.assign(this->_maxSize, -1);
+    for (size_t i = 0; i < this->_maxSize && !cpuList.empty(); i++)
+    {
+        this->_cpus[i] = cpuList[i % cpuList.size()];
+        this->_nodes[i] = util::GetCpuNode(this->_cpus[i]);
+        LOG_INFO << "IOService " << i << ": cpu " << this->_cpus[i] << ", node " << this->_nodes[i] << std::endl;
+    }
+
+    // 新连接引导至网卡所在节点的上下文，无匹配（未绑核、节点未知）时使用全部上下文
+    auto &nic = config.GetAffinityNic();
+    int nicNode = nic.empty() ? -1 : util::GetNetDeviceNode(nic);
+    for (size_t i = 0; i < this->_maxSize; i++)
+    {
+        if (nicNode >= 0 && this->_nodes[i] == nicNode)
+            this->_acceptIndices.push_back(i);
+    }
+    if (!nic.empty())
+    {
+        LOG_INFO << "NIC " << nic << " on node " << nicNode << ", accept contexts: " << this->_acceptIndices.size() << std::endl;
+    }
+    if (this->_acceptIndices.empty())
+    {
+        for (size_t i = 0; i < this->_maxSize; i++)
+        {
+            this->_acceptIndices.push_back(i);
+        }
     }
 }
 
@@ -40,8 +119,40 @@ boost::asio::io_context &AsioIOServicePool::GetIOServive()
     return this->_ioServices[this->_nextIndex++ % this->_maxSize];
 }
 
+boost::asio::io_context &AsioIOServicePool::GetAcceptIOService()
+{
+    auto index = this->_nextAcceptIndex++ % this->_acceptIndices.size();
+    return this->_ioServices[this->_acceptIndices[index]];
+}
+
+DispatchScheduler *AsioIOServicePool::GetScheduler(boost::asio::io_context &ioc)
+{
+    for (size_t i = 0; i < this->_schedulers.size(); i++)
+    {
+        if (&this->_ioServices[i] == &ioc)
+            return this->_schedulers[i].get();
+    }
+    return nullptr;
+}
+
+IdleWheel *AsioIOServicePool::GetIdleWheel(boost::asio::io_context &ioc)
+{
+    for (size_t i = 0; i < this->_idleWheels.size(); i++)
+    {
+        if (&this->_ioServices[i] == &ioc)
+            return this->_idleWheels[i].get();
+    }
+    return nullptr;
+}
+
 void AsioIOServicePool::Stop()
 {
+    // 停止时间轮定时器，否则 io_context 始终有待处理的任务
+    for (auto &wheel : this->_idleWheels)
+    {
+        wheel->Stop();
+    }
+
     for (auto &work : this->_works)
     {
         // 释放 unique_ptr，调用析构，从而关闭 iocontext
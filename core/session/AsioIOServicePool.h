@@ -10,6 +10,9 @@
 #include <vector>
 #include <boost/asio.hpp>
 
+#include "IdleWheel.h"
+#include "../logic/DispatchScheduler.h"
+
 class AsioIOServicePool
 {
 public:
@@ -26,6 +29,18 @@ public:
     // 对外接口
     // 获取 IOService
     boost::asio::io_context &GetIOServive();
+    // 获取 io_context 对应的空闲检测时间轮，未启用空闲检测或不属于本池时返回 nullptr
+    IdleWheel *GetIdleWheel(boost::asio::io_context &ioc);
+    // 获取 io_context 对应的请求分发调度器，未启用调度或不属于本池时返回 nullptr
+    DispatchScheduler *GetScheduler(boost::asio::io_context &ioc);
+    // 获取用于新连接的 IOService：启用网卡节点引导时仅在网卡所在 NUMA 节点的上下文中轮询
+    boost::asio::io_context &GetAcceptIOService();
+    // 获取用于新连接的 IOService 下标（SO_REUSEPORT 模式下只在这些上下文中启动监听器）
+    const std::vector<std::size_t> &GetAcceptIndices() const { return this->_acceptIndices; }
+    // 获取指定下标的 IOService（用于每个上下文各自运行的组件，如 SO_REUSEPORT 监听器）
+    boost::asio::io_context &GetIOService(std::size_t index) { return this->_ioServices[index]; }
+    // 获取 IOService 数量
+    std::size_t GetSize() const { return this->_maxSize; }
     // 停止
     void Stop();
 
@@ -35,11 +50,23 @@ public:
 private:
     // 私有构造函数
     AsioIOServicePool(std::size_t size);
+    // 按配置计算各线程绑定的 CPU、所在 NUMA 节点及接收新连接的上下文
+    void InitPlacement();
 
     // 服务数组
     std::vector<IOService> _ioServices;
     std::vector<WorkPtr> _works;
     std::vector<std::thread> _threads;
+    // 每个 io_context 一个空闲检测时间轮（下标与 _ioServices 对应）
+    std::vector<std::unique_ptr<IdleWheel>> _idleWheels;
+    // 每个 io_context 一个请求分发调度器（下标与 _ioServices 对应）
+    std::vector<std::unique_ptr<DispatchScheduler>> _schedulers;
+    // 每个线程绑定的 CPU（-1 表示不绑定）及所在 NUMA 节点（-1 表示未知）
+    std::vector<int> _cpus;
+    std::vector<int> _nodes;
+    // 接收新连接的上下文下标
+    std::vector<std::size_t> _acceptIndices;
+    std::atomic<std::size_t> _nextAcceptIndex{0};
     // 原子变量，用于记录下一个 IOService 的索引，避免竞争
     std::atomic<std::size_t> _nextIndex;
     std::size_t _maxSize;
@@ -2,24 +2,32 @@
 #include "CSession.h"
 #include "../common/Const.h"
 #include "../message/MsgNode.h"
+#include "../protocol/BodyCodec.h"
+#include "../protocol/Compressor.h"
 #include "../server/CServer.h"
+#include "AsioIOServicePool.h"
+
+#include <thread>
 
 #include "../../infra/log/Logger.h"
+#include "../../infra/metrics/Metrics.h"
+#include "../../config/ConfigManager.h"
 #include "../../services/CommunicationService/ClientInfo.h"
 #include "../../services/CommunicationService/ClientManager.h"
 
 CSession::CSession(boost::asio::io_context &ioc, boost::asio::ip::tcp::socket socket, CServer *server)
-    : _ioc(ioc),
+    : _id(SessionIdAllocator::GetInstance().Allocate()),
+      _ioc(ioc),
       _server(server),
       _socket(std::move(socket)), // 使用移动语义
+      _sendInbox(MAX_SENDQUE_LEN),
       _bStop(false),
+      _assembler(ConfigManager::GetInstance().GetMaxMessageSize()),
+      _idleWheel(AsioIOServicePool::GetInstance().GetIdleWheel(ioc)),
       _clientInfo(nullptr)
 {
-    // 随机生成 uuid
-    auto uuid = boost::uuids::random_generator()();
-    this->_uuid = boost::uuids::to_string(uuid);
     // 初始化消息节点
-    this->_recvNode = std::make_shared<MsgNode>();
+    this->_recvNode = MsgNode::Create();
 }
 
 CSession::~CSession()
@@ -60,6 +68,22 @@ CSession::~CSession()
     {
         std::cerr << "Destructor Unknown Exception" << std::endl;
     }
+
+    // 归还会话标识（槽位可被新会话复用，旧标识随即失效）
+    SessionIdAllocator::GetInstance().Release(this->_id);
+}
+
+void CSession::StartIdleCheck()
+{
+    if (this->_idleWheel)
+        this->_idleWheel->Add(shared_from_this());
+}
+
+void CSession::OnIdleTimeout()
+{
+    LOG_WARN << "Client heartbeat timeout! Force Close. Session: " << FormatSessionId(this->_id) << std::endl;
+    Close();
+    this->_server->DelSessionById(this->_id);
 }
 
 void CSession::Close()
@@ -72,108 +96,434 @@ void CSession::Close()
     boost::asio::post(_ioc, [self = shared_from_this()]()
                       {
         boost::system::error_code ec;
-        self->_socket.close(ec); });
+        self->_socket.close(ec);
+        self->OnClosed(); });
+}
+
+void CSession::Send(const MessageHeader &header, const std::string &body)
+{
+    // 拷贝一份消息体，由发送节点持有
+    Send(header, std::string(body));
+}
+
+void CSession::Send(const MessageHeader &header, std::string &&body)
+{
+    SendBody(header, std::move(body), false);
 }
 
-void CSession::Send(const MessageHeader &header, const char *body, const uint32_t &len)
+void CSession::Push(const MessageHeader &header, const nlohmann::json &body)
+{
+    SendBody(header, BodyCodec::Encode(header, body), true);
+}
+
+void CSession::SendBody(const MessageHeader &header, std::string &&body, bool push)
 {
     if (_bStop)
         return;
 
-    // 构造 MsgNode（在调用线程完成，避免阻塞 IO 线程）
-    // 注意传入的数量 ！！！
-    auto node = std::make_shared<MsgNode>(len);
+    // 是否压缩、是否分片由本次发送决定，不沿用请求帧的标志
+    MessageHeader hdr = header;
+    hdr.SetFlag(HEADER_FLAG_COMPRESSED, false);
+    hdr.SetFlag(HEADER_FLAG_MORE, false);
 
-    // 拷贝 Header
-    node->GetHeader() = header;
-    // 重新获取长度
-    node->GetHeader().length = len;
+    // 超过单帧上限，分片发送，各分片共享同一份消息体
+    if (body.size() > ConfigManager::GetInstance().GetMaxFrameSize())
+    {
+        auto holder = std::make_shared<const std::string>(std::move(body));
+        SendChunks(hdr, holder, holder->data(), holder->size(), true, push);
+        return;
+    }
 
-    // 拷贝 Body
-    if (len > 0 && body != nullptr)
+    std::string compressed;
+    if (TryCompress(hdr, body.data(), body.size(), compressed))
     {
-        std::memcpy(node->GetBody(), body, len);
+        body = std::move(compressed);
     }
 
-    // 转网络字节序（只在发送前做一次）
-    node->GetHeader().ToNetwork();
+    // 消息体直接移动至发送节点，Header 单独存放，发送时不再拼接
+    PostSend(SendNode::Create(hdr, std::move(body)), push, ConfigManager::GetInstance().GetPriority(hdr.serviceId, hdr.cmdId));
+}
 
-    // 构建连续发送缓冲区
-    node->BuildSendBuffer();
+void CSession::Send(const MessageHeader &header, const nlohmann::json &body)
+{
+    // 按帧标志选择 JSON / 二进制编码，序列化结果直接移动，不做拷贝
+    Send(header, BodyCodec::Encode(header, body));
+}
 
-    auto self = shared_from_this();
+// 外部消息体按原样发送（帧标志由调用方负责）
+void CSession::Send(const MessageHeader &header, std::shared_ptr<const void> holder, const char *body, uint32_t len)
+{
+    if (_bStop)
+        return;
 
-    // LOG_INFO << "Send Data." << std::endl;
+    // 超过单帧上限，分片发送
+    if (len > ConfigManager::GetInstance().GetMaxFrameSize())
+    {
+        MessageHeader hdr = header;
+        hdr.SetFlag(HEADER_FLAG_MORE, false);
+        SendChunks(hdr, std::move(holder), body, len, false, false);
+        return;
+    }
 
-    // 投递到 io_context
-    boost::asio::post(_ioc, [this, self, node]()
-                      { DoSend(node); });
+    PostSend(SendNode::Create(header, std::move(holder), body, len), false, ConfigManager::GetInstance().GetPriority(header.serviceId, header.cmdId));
 }
 
-void CSession::Send(const MessageHeader &header, const std::string &body)
+void CSession::Send(const std::vector<std::shared_ptr<const SharedFrame>> &frames)
 {
-    Send(header, body.c_str(), body.length());
+    if (_bStop || frames.empty())
+        return;
+
+    // 各分片串成一条链整体投递
+    auto head = SendNode::Create(frames.front());
+    SendNode *tail = head.get();
+    for (std::size_t i = 1; i < frames.size(); i++)
+    {
+        auto node = SendNode::Create(frames[i]);
+        SendNode *raw = node.get();
+        tail->SetNext(std::move(node));
+        tail = raw;
+    }
+
+    // 共享帧以推送方式发送，不参与请求响应的顺序释放
+    PostSend(std::move(head), true);
 }
 
-void CSession::Send(const MessageHeader &header, const nlohmann::json &body)
+void CSession::SendChunks(const MessageHeader &header, std::shared_ptr<const void> holder, const char *body, std::size_t len, bool compress, bool push)
 {
-    // 发送
-    Send(header, body.dump(4));
+    std::size_t maxFrameSize = ConfigManager::GetInstance().GetMaxFrameSize();
+    // 同一消息的分片优先级相同，进入同一发送队列，保持分片顺序
+    auto priority = ConfigManager::GetInstance().GetPriority(header.serviceId, header.cmdId);
+
+    // 各分片串成一条链整体投递，其他线程并发发送的帧不会插入分片之间，除最后一片外均带 MORE 标志
+    std::shared_ptr<SendNode> head;
+    SendNode *tail = nullptr;
+    auto append = [&head, &tail](std::shared_ptr<SendNode> node)
+    {
+        SendNode *raw = node.get();
+        if (tail)
+            tail->SetNext(std::move(node));
+        else
+            head = std::move(node);
+        tail = raw;
+    };
+
+    for (std::size_t offset = 0; offset < len; offset += maxFrameSize)
+    {
+        std::size_t chunkLen = std::min(maxFrameSize, len - offset);
+        MessageHeader chunkHdr = header;
+        chunkHdr.SetFlag(HEADER_FLAG_MORE, offset + chunkLen < len);
+
+        // 每个分片独立压缩，接收方可逐片解压
+        std::string compressed;
+        if (compress && TryCompress(chunkHdr, body + offset, chunkLen, compressed))
+        {
+            append(SendNode::Create(chunkHdr, std::move(compressed)));
+        }
+        else
+        {
+            append(SendNode::Create(chunkHdr, holder, body + offset, static_cast<uint32_t>(chunkLen)));
+        }
+    }
+
+    if (head)
+        PostSend(std::move(head), push, priority);
+}
+
+void CSession::PostSend(std::shared_ptr<SendNode> node, bool push, MSG_PRIORITY priority)
+{
+    // 分片链上的各帧标志相同，积压按整条链计入
+    std::size_t bytes = 0;
+    for (auto frame = node.get(); frame != nullptr; frame = frame->GetNext().get())
+    {
+        frame->SetPush(push);
+        frame->SetPriority(priority);
+        bytes += frame->GetSendSize();
+    }
+
+    // 已有的发送积压超过硬上限：对端长期不读取（慢消费者），断开连接
+    if (!AddQueuedBytes(bytes))
+    {
+        LOG_WARN << "Session " << FormatSessionId(this->_id) << " send backlog exceeds hard limit, close it." << std::endl;
+        Metrics::GetInstance().RecordSlowConsumer();
+        // 与读取出错相同的清理路径：关闭并从服务器移除，不再可被查找到
+        Close();
+        this->_server->DelSessionById(this->_id);
+        return;
+    }
+
+    // 快速路径：调用方已运行在本会话的 io_context 线程（请求/响应的常见情况），直接入发送队列并发起写入
+    if (IsInIoThread())
+    {
+        DoSend(std::move(node));
+        return;
+    }
+
+    // 跨线程：无锁入队（积压已由字节数限制），队列槽位已满时转入溢出队列，不丢弃
+    // 溢出队列非空期间，后续的帧同样进入溢出队列，不会越过同一生产者先前溢出的帧
+    if (this->_sendOverflowing.load(std::memory_order_acquire) || !this->_sendInbox.TryPush(node))
+    {
+        std::lock_guard<std::mutex> lock(this->_overflowMutex);
+        this->_sendOverflow.push_back(std::move(node));
+        this->_sendOverflowing.store(true, std::memory_order_release);
+    }
+
+    // 仅在写入方未被唤醒时投递一次，此后入队的帧由同一次 DrainInbox 批量取走
+    if (!this->_writeArmed.exchange(true, std::memory_order_acq_rel))
+    {
+        auto self = shared_from_this();
+        boost::asio::post(_ioc, [this, self]()
+                          { DrainInbox(); });
+    }
+}
+
+void CSession::DrainInbox()
+{
+    for (;;)
+    {
+        PullInbox();
+
+        // 解除唤醒标志后再检查一次：生产者可能在最后一次出队之后入队，且看到标志仍置位而没有投递
+        // （两侧均为 acq_rel 的 exchange，生产者的入队对此处可见）
+        this->_writeArmed.exchange(false, std::memory_order_acq_rel);
+        bool empty = this->_sendInbox.Empty() && !this->_sendOverflowing.load(std::memory_order_acquire);
+        if (empty || this->_writeArmed.exchange(true, std::memory_order_acq_rel))
+            return;
+    }
+}
+
+bool CSession::AddQueuedBytes(std::size_t bytes)
+{
+    auto &config = ConfigManager::GetInstance();
+    auto backlog = this->_queuedBytes.fetch_add(bytes, std::memory_order_relaxed);
+    auto total = backlog + bytes;
+
+    // 只比较已有的积压：单条消息再大，对端已读完之前的数据时也不算慢消费者
+    if (backlog > config.GetSendHardLimit())
+    {
+        this->_queuedBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 超过高水位，通知读取方暂停
+    if (total >= config.GetSendHighWatermark() && !this->_sendBlocked.exchange(true))
+    {
+        Metrics::GetInstance().RecordReadPause();
+    }
+    return true;
+}
+
+void CSession::SubQueuedBytes(std::size_t bytes)
+{
+    auto total = this->_queuedBytes.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+
+    // 低于低水位，恢复读取
+    if (total <= ConfigManager::GetInstance().GetSendLowWatermark() && this->_sendBlocked.exchange(false))
+    {
+        OnSendResumed();
+    }
+}
+
+void CSession::PullInbox()
+{
+    std::shared_ptr<SendNode> node;
+    while (this->_sendInbox.TryPop(node))
+    {
+        DoSend(std::move(node));
+    }
+
+    if (!this->_sendOverflowing.load(std::memory_order_acquire))
+        return;
+
+    // 取出溢出队列：生产者进入溢出队列前在无锁队列中的帧须先发送，
+    // 因此持锁取完无锁队列（包括正在写入的帧，等待极短）后再取溢出队列，发送在锁外进行
+    std::vector<std::shared_ptr<SendNode>> batch;
+    {
+        std::lock_guard<std::mutex> lock(this->_overflowMutex);
+        while (!this->_sendInbox.Idle())
+        {
+            if (this->_sendInbox.TryPop(node))
+                batch.push_back(std::move(node));
+            else
+                std::this_thread::yield();
+        }
+        for (auto &item : this->_sendOverflow)
+        {
+            batch.push_back(std::move(item));
+        }
+        this->_sendOverflow.clear();
+        this->_sendOverflowing.store(false, std::memory_order_release);
+    }
+    for (auto &item : batch)
+    {
+        DoSend(std::move(item));
+    }
+}
+
+bool CSession::TryCompress(MessageHeader &header, const char *data, std::size_t len, std::string &out)
+{
+    // 对端未声明可接收压缩
+    if ((this->_peerFlags & HEADER_FLAG_ACCEPT_COMPRESS) == 0)
+        return false;
+
+    // 该服务未配置压缩，或未达到阈值
+    auto &config = ConfigManager::GetInstance();
+    auto threshold = config.GetCompressionThreshold(header.serviceId);
+    if (!threshold || len < *threshold)
+        return false;
+
+    auto start = std::chrono::steady_clock::now();
+    if (!Compressor::Compress(data, len, config.GetCompressionLevel(), out))
+        return false;
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    Metrics::GetInstance().RecordCompress(len, out.size(), nanos);
+
+    header.SetFlag(HEADER_FLAG_COMPRESSED, true);
+    return true;
+}
+
+bool CSession::PrepareInbound(std::shared_ptr<MsgNode> &msg)
+{
+    auto &header = msg->GetHeader();
+
+    // 记录对端使用的编码方式及是否接收压缩
+    UpdatePeerFlags(header);
+
+    // 未压缩，直接分发
+    if (!header.HasFlag(HEADER_FLAG_COMPRESSED))
+        return true;
+
+    // 检查原始长度（每个分片独立压缩，解压后同样不超过单帧上限），防止伪造长度导致超大内存分配
+    auto originalLen = Compressor::GetOriginalSize(msg->GetBody(), msg->GetBodyLen());
+    if (!originalLen || *originalLen > ConfigManager::GetInstance().GetMaxFrameSize())
+    {
+        LOG_WARN << "Session " << FormatSessionId(this->_id) << " invalid compressed frame, drop it." << std::endl;
+        return false;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // 解压至新的消息节点
+    auto plain = MsgNode::Create(*originalLen);
+    plain->GetHeader() = header;
+    plain->GetHeader().length = *originalLen;
+    plain->GetHeader().SetFlag(HEADER_FLAG_COMPRESSED, false);
+    if (!Compressor::Decompress(msg->GetBody(), msg->GetBodyLen(), plain->GetBody(), *originalLen))
+    {
+        LOG_WARN << "Session " << FormatSessionId(this->_id) << " decompress frame failed, drop it." << std::endl;
+        return false;
+    }
+
+    auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    Metrics::GetInstance().RecordDecompress(msg->GetBodyLen(), *originalLen, nanos);
+
+    msg = std::move(plain);
+    return true;
+}
+
+bool CSession::AssembleInbound(std::shared_ptr<MsgNode> &msg)
+{
+    switch (this->_assembler.Feed(msg))
+    {
+    case ChunkAssembler::Result::Complete:
+        return true;
+    case ChunkAssembler::Result::Pending:
+        return false;
+    case ChunkAssembler::Result::Overflow:
+    default:
+        LOG_WARN << "Session " << FormatSessionId(this->_id) << " chunked message exceeds receive budget, close it." << std::endl;
+        Close();
+        this->_server->DelSessionById(this->_id);
+        return false;
+    }
 }
 
 void CSession::ClientClose()
 {
     LOG_INFO << "CoroutineSession: Client Close a Connect." << std::endl;
     Close();
-    this->_server->DelSessionByUuid(this->_uuid);
+    this->_server->DelSessionById(this->_id);
 }
 
-bool CSession::SendToOtherSession(const std::string &uuid, const MessageHeader &header, const std::string &body)
+std::size_t CSession::BroadcastToSessions(const std::vector<SessionId> &ids, const MessageHeader &header, const nlohmann::json &body)
+{
+    // 每种编码方式至多编码一次，所有接收方共享同一组帧（超过单帧上限时切分为共享分片）
+    std::vector<std::shared_ptr<const SharedFrame>> frames[2];
+    std::size_t count = 0;
+
+    for (auto id : ids)
+    {
+        auto session = this->_server->GetSessionById(id);
+        if (session == nullptr)
+            continue;
+
+        // 按接收方自身的编码方式分组（广播帧不压缩，避免逐个接收方压缩）
+        bool binary = (session->GetPeerFlags() & HEADER_FLAG_BINARY) != 0;
+        auto &group = frames[binary ? 1 : 0];
+        if (group.empty())
+        {
+            MessageHeader frameHdr = header;
+            frameHdr.SetFlag(HEADER_FLAG_BINARY, binary);
+            frameHdr.SetFlag(HEADER_FLAG_COMPRESSED, false);
+            group = SharedFrame::CreateChunks(frameHdr, BodyCodec::Encode(frameHdr, body), ConfigManager::GetInstance().GetMaxFrameSize());
+        }
+
+        session->Send(group);
+        ++count;
+    }
+
+    return count;
+}
+
+bool CSession::SendToOtherSession(SessionId id, const MessageHeader &header, const nlohmann::json &body)
 {
     // 获取其他会话
-    auto session = this->_server->GetSessionByUuid(uuid);
+    auto session = this->_server->GetSessionById(id);
 
     // 如果不存在，则返回 false
     if (session == nullptr)
         return false;
 
-    LOG_INFO << "SendToOtherSession: " << uuid << std::endl;
+    LOG_INFO << "SendToOtherSession: " << FormatSessionId(id) << std::endl;
     LOG_INFO << "SendToOtherSession: " << session->GetSocket().remote_endpoint() << std::endl;
-    // 发送信息
-    session->Send(header, body);
+    // 按接收方自身的编码方式发送，而非发送方的
+    MessageHeader forwardHdr = header;
+    forwardHdr.SetFlag(HEADER_FLAG_BINARY, (session->GetPeerFlags() & HEADER_FLAG_BINARY) != 0);
+    // 以推送方式发送，不参与对方会话中请求响应的顺序释放
+    session->Push(forwardHdr, body);
 
     return true;
 }
 
-void CSession::HandleWrite(const boost::system::error_code &error)
+void CSession::HandleWrite(const boost::system::error_code &error, std::size_t bytes_transferred)
 {
     try
     {
         if (!error)
         {
-            // 加锁 (保护队列操作)
-            std::unique_lock<std::mutex> lock(this->_mutex);
-
-            // 1. 移除刚刚发送完成的节点
-            if (!this->_sendQue.empty())
+            // 空闲检测：写出进展同样说明对端仍在接收
+            TouchIdle();
+            // 记录本轮合并写的帧数
+            Metrics::GetInstance().RecordWrite(this->_writingCount, bytes_transferred);
+            // 释放发送积压，低于低水位时恢复读取
+            SubQueuedBytes(bytes_transferred);
+
+            // 1. 移除本轮已发送完成的所有节点（发送队列仅在 io_context 线程访问，无需加锁）
+            for (std::size_t i = 0; i < this->_writingControl && !this->_controlQue.empty(); ++i)
             {
-                this->_sendQue.pop();
+                this->_controlQue.pop_front();
             }
-
-            // 2. 检查是否还有待发送的消息
-            if (!this->_sendQue.empty())
+            for (std::size_t i = this->_writingControl; i < this->_writingCount && !this->_sendQue.empty(); ++i)
             {
-                // 获取下一个节点
-                auto msgNode = this->_sendQue.front();
-
-                // 解锁 (async_write 不需要持有锁，且 msgNode 是 shared_ptr 安全的)
-                lock.unlock();
+                this->_sendQue.pop_front();
+            }
+            this->_writingCount = 0;
+            this->_writingControl = 0;
 
-                // 3. 必须发送 Header + Body (GetSendData)，不能只发 Body
-                boost::asio::async_write(
-                    this->_socket,
-                    boost::asio::buffer(msgNode->GetSendData(), msgNode->GetSendSize()),
-                    std::bind(&CSession::HandleWrite, shared_from_this(), std::placeholders::_1));
+            // 2. 写入期间新入队的消息，合并为下一轮写入（控制消息优先）
+            if (!this->_controlQue.empty() || !this->_sendQue.empty())
+            {
+                DoWrite();
             }
         }
         else
@@ -193,54 +543,170 @@ void CSession::HandleWrite(const boost::system::error_code &error)
     }
 }
 
-void CSession::DoSend(std::shared_ptr<MsgNode> node)
+bool CSession::BeginOrdered(uint64_t key)
 {
-    if (this->_bStop)
+    // 槽位按消息键匹配响应：同一 (serviceId, cmdId, seq) 已有未完成的请求时无法区分响应归属，拒绝登记
+    for (auto &slot : this->_orderSlots)
+    {
+        if (!slot.done && slot.key == key)
+            return false;
+    }
+
+    this->_orderSlots.push_back(OrderSlot{key, false, {}});
+    return true;
+}
+
+void CSession::EndOrdered(uint64_t key)
+{
+    // 已在 io_context 线程，直接释放
+    if (IsInIoThread())
+    {
+        ReleaseOrdered(key);
         return;
+    }
+
+    auto self = shared_from_this();
+    boost::asio::post(_ioc, [this, self, key]()
+                      { ReleaseOrdered(key); });
+}
+
+void CSession::ReleaseOrdered(uint64_t key)
+{
+    // 先取走无锁队列中已入队的（跨线程）响应，确保其进入槽位
+    PullInbox();
 
-    // 加锁 (保护队列操作)
-    std::unique_lock<std::mutex> lock(this->_mutex);
+    // 标记该请求已完成
+    for (auto &slot : this->_orderSlots)
+    {
+        if (!slot.done && slot.key == key)
+        {
+            slot.done = true;
+            break;
+        }
+    }
 
-    // 检查队列长度限制
-    if (this->_sendQue.size() >= MAX_SENDQUE_LEN)
+    // 释放队首已完成的请求，新的队首请求缓存的响应依次进入发送队列
+    while (!this->_orderSlots.empty() && this->_orderSlots.front().done)
     {
-        LOG_WARN << "Session " << this->_uuid << " send queue full\n";
+        this->_orderSlots.pop_front();
+        if (this->_orderSlots.empty())
+            break;
+
+        auto pending = std::move(this->_orderSlots.front().pending);
+        for (auto &node : pending)
+        {
+            EnqueueSend(std::move(node));
+        }
+    }
+}
+
+void CSession::DoSend(std::shared_ptr<SendNode> node)
+{
+    // 展开分片链，各分片连续进入同一槽位或发送队列
+    while (node)
+    {
+        auto next = node->TakeNext();
+        DoSendFrame(std::move(node));
+        node = std::move(next);
+    }
+}
+
+void CSession::DoSendFrame(std::shared_ptr<SendNode> node)
+{
+    if (this->_bStop)
         return;
+
+    // 属于尚未轮到的请求（前面还有未完成的请求），先缓存在槽位中（控制消息不参与顺序释放）
+    if (!node->IsPush() && node->GetPriority() != PRIORITY_CONTROL)
+    {
+        for (auto &slot : this->_orderSlots)
+        {
+            if (slot.done || slot.key != node->GetMessageKey())
+                continue;
+
+            if (&slot != &this->_orderSlots.front())
+            {
+                slot.pending.push_back(std::move(node));
+                return;
+            }
+            break;
+        }
     }
 
-    // ✅ 修复：在 push 之前判断是否需要触发 Write
-    bool writing = !this->_sendQue.empty();
-    this->_sendQue.push(node);
+    EnqueueSend(std::move(node));
+}
+
+void CSession::EnqueueSend(std::shared_ptr<SendNode> node)
+{
+    if (this->_bStop)
+        return;
+
+    // ✅ 修复：在 push 之前判断是否需要触发 Write（写入中的节点保留在队列中，直至写入完成）
+    bool writing = !this->_sendQue.empty() || !this->_controlQue.empty();
+    if (node->GetPriority() == PRIORITY_CONTROL)
+        this->_controlQue.push_back(std::move(node));
+    else
+        this->_sendQue.push_back(std::move(node));
 
     // 如果之前队列为空，说明当前没有 Write 任务在运行，需要主动触发
     if (!writing)
     {
-        // 释放锁后再调用 DoWrite，防止 DoWrite 内部死锁 (虽然目前 DoWrite 逻辑简单，但这是好习惯)
-        lock.unlock();
         DoWrite();
     }
 }
 
 void CSession::DoWrite()
 {
-    // 加锁 (保护队列操作)
-    std::unique_lock<std::mutex> lock(this->_mutex);
-
-    if (this->_sendQue.empty())
+    if (this->_sendQue.empty() && this->_controlQue.empty())
         return;
 
-    auto self = shared_from_this();
-    auto node = _sendQue.front(); // 获取 shared_ptr 副本，确保在 async_write 期间存活
+    // 合并队首的多个帧为一次 gather 写（帧数与字节数均有上限，至少发送一帧）
+    // 先取控制消息队列，再取普通消息队列：控制消息最多等待一轮正在进行的写入
+    // 控制消息只在消息边界插入：普通消息的分片尚未写完时不取控制消息，控制消息未取完时不取普通消息
+    // 节点在发送完成前仍保留在队列中，确保 async_write 期间存活
+    this->_writeBufs.clear();
+    std::size_t bytes = 0;
+    std::size_t count = 0;
+    // 返回是否取完了整个队列
+    auto gather = [this, &bytes, &count](const std::deque<std::shared_ptr<SendNode>> &que)
+    {
+        for (auto &node : que)
+        {
+            if (count >= MAX_WRITE_FRAMES || (count > 0 && bytes + node->GetSendSize() > MAX_WRITE_BYTES))
+                return false;
 
-    // 解锁
-    lock.unlock();
+            auto buffers = node->GetBuffers();
+            this->_writeBufs.insert(this->_writeBufs.end(), buffers.begin(), buffers.end());
+            bytes += node->GetSendSize();
+            ++count;
+        }
+        return true;
+    };
+    bool controlDone = true;
+    if (!this->_bulkInMessage || this->_sendQue.empty())
+    {
+        controlDone = gather(this->_controlQue);
+    }
+    this->_writingControl = count;
+    if (controlDone)
+    {
+        gather(this->_sendQue);
+    }
+    this->_writingCount = count;
+    // 记录本轮最后写出的普通消息帧是否停在分片中间（本轮未取普通消息时保持不变）
+    if (this->_writingCount > this->_writingControl)
+    {
+        this->_bulkInMessage = this->_sendQue[this->_writingCount - this->_writingControl - 1]->HasMore();
+    }
+
+    auto self = shared_from_this();
 
     // 发送
     boost::asio::async_write(
         this->_socket,
-        boost::asio::buffer(node->GetSendData(), node->GetSendSize()), // 需发送：Header + Body
-        [this, self](const boost::system::error_code &ec, std::size_t)
+        this->_writeBufs, // 需发送：多个 Header + Body（gather 写，无需拼接）
+        [this, self](const boost::system::error_code &ec, std::size_t bytes_transferred)
         {
-            HandleWrite(ec);
+            HandleWrite(ec, bytes_transferred);
         });
-}
\ No newline at end of file
+}
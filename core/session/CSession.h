@@ -3,15 +3,21 @@
 #define CSESSION_H
 
 #include <boost/asio.hpp>
-#include <boost/uuid/uuid_io.hpp>
-#include <boost/uuid/uuid_generators.hpp>
 
-#include <queue>
+#include <deque>
+#include <vector>
 #include <memory>
 #include <mutex>
+#include <string>
 
 #include "../../infra/util/json.hpp"
+#include "../../infra/util/MpscQueue.h"
 #include "../message/MsgNode.h"
+#include "../message/SendNode.h"
+#include "../message/SharedFrame.h"
+#include "../message/ChunkAssembler.h"
+#include "SessionId.h"
+#include "IdleWheel.h"
 
 // 前置声明
 class CServer;
@@ -34,10 +40,19 @@ public:
     // 关闭会话
     void Close();
     // 对外接口
+    // 拷贝一次消息体
     void Send(const MessageHeader &header, const std::string &);
+    // 移动消息体，不做拷贝
+    void Send(const MessageHeader &header, std::string &&body);
     void Send(const MessageHeader &header, const nlohmann::json &body);
+    // 引用外部消息体（如接收缓冲区、共享结果），holder 保证发送完成前内存有效
+    void Send(const MessageHeader &header, std::shared_ptr<const void> holder, const char *body, uint32_t len);
+    // 主动推送（如转发其他会话的消息），不参与请求响应的顺序释放
+    void Push(const MessageHeader &header, const nlohmann::json &body);
+    // 推送已编码的共享帧（不拷贝），同一组帧可同时发给多个会话；多个帧为同一消息的分片，整体入队
+    void Send(const std::vector<std::shared_ptr<const SharedFrame>> &frames);
     // 获取唯一标识符
-    const std::string &GetUuid() const { return this->_uuid; };
+    SessionId GetId() const { return this->_id; }
     // 获取 IO 上下文
     boost::asio::io_context &GetIoContext() { return this->_ioc; }
 
@@ -45,39 +60,152 @@ public:
     void SetClientInfo(std::shared_ptr<ClientInfo> clientInfo) { this->_clientInfo = std::move(clientInfo); }
     // 获取客户端信息
     std::shared_ptr<ClientInfo> GetClientInfo() { return this->_clientInfo; }
+    // 设置客户端名称（用于按名称查找调度权重）
+    void SetClientName(const std::string &name) { this->_clientName = name; }
+    // 获取客户端名称，未注册时为空
+    const std::string &GetClientName() const { return this->_clientName; }
 
     // 客户端主动关闭会话
     void ClientClose();
-    // 通过 server 访问其他会话
-    bool SendToOtherSession(const std::string &uuid, const MessageHeader &header, const std::string &body);
+    // 通过 server 访问其他会话（按接收方的编码方式编码消息体）
+    bool SendToOtherSession(SessionId id, const MessageHeader &header, const nlohmann::json &body);
+    // 广播至多个会话：按接收方编码方式分组，每组只编码一次，返回实际发送的会话数
+    std::size_t BroadcastToSessions(const std::vector<SessionId> &ids, const MessageHeader &header, const nlohmann::json &body);
+    // 发送积压是否超过高水位（读取方应暂停读取，直至低于低水位）
+    bool IsSendBlocked() const { return this->_sendBlocked.load(); }
+    // 获取对端最近一次请求携带的帧标志（编码方式等）
+    uint16_t GetPeerFlags() const { return this->_peerFlags; }
+    // 会话是否已关闭
+    bool IsClosed() const { return this->_bStop.load(); }
+
+    // 读取是否因背压暂停（在途请求占满窗口或发送积压，io_context 线程），暂停期间读不到对端的心跳，不做空闲检测
+    virtual bool IsReadPaused() const { return false; }
+    // 空闲检测：记录活动（读取或写出完成时，io_context 线程）
+    void TouchIdle()
+    {
+        if (this->_idleWheel)
+            this->_idleTick = this->_idleWheel->Now();
+    }
+    // 空闲检测：最近一次活动的 tick（io_context 线程）
+    uint64_t GetIdleTick() const { return this->_idleTick; }
+    // 空闲超时，由时间轮调用（io_context 线程）
+    void OnIdleTimeout();
 
 protected:
     // 处理写事件
-    void HandleWrite(const boost::system::error_code &error);
-    void DoSend(std::shared_ptr<MsgNode>);
+    void HandleWrite(const boost::system::error_code &error, std::size_t bytes_transferred);
+    // 发送节点（及其分片链）依次进入顺序释放槽位或发送队列
+    void DoSend(std::shared_ptr<SendNode>);
+    // 单个帧进入顺序释放槽位或发送队列
+    void DoSendFrame(std::shared_ptr<SendNode> node);
     void DoWrite();
+    // 发送节点加入发送队列，必要时发起写入
+    void EnqueueSend(std::shared_ptr<SendNode> node);
+
+    // 编码后的消息体：压缩、分片后投递
+    void SendBody(const MessageHeader &header, std::string &&body, bool push);
+    // 发送节点（含分片链，整条链作为一个单元）无锁入队，必要时唤醒 io_context 线程
+    void PostSend(std::shared_ptr<SendNode> node, bool push = false, MSG_PRIORITY priority = PRIORITY_BULK);
+    // io_context 线程：批量取出无锁队列中的发送节点，队列为空后解除唤醒标志
+    void DrainInbox();
+    // io_context 线程：取出无锁队列及溢出队列中当前所有发送节点
+    void PullInbox();
+
+    // 顺序释放：在 io_context 线程中、分发请求前登记槽位，此后该请求的响应按请求到达顺序发送
+    // 槽位以 MessageHeader::GetMessageKey 匹配响应，同一 (serviceId, cmdId, seq) 已有未完成的请求时返回 false（不登记，调用方应拒绝该请求）
+    bool BeginOrdered(uint64_t key);
+    // 顺序释放：请求处理完成（可在任意线程调用）
+    void EndOrdered(uint64_t key);
+    // 顺序释放：在 io_context 线程中标记完成，并释放队首已完成请求的响应
+    void ReleaseOrdered(uint64_t key);
 
-    // 私有发送事件
-    void Send(const MessageHeader &header, const char *body, const uint32_t &len);
+    // 发送积压计数：入队时增加，入队前已有的积压超过硬上限时返回 false（不计入）
+    bool AddQueuedBytes(std::size_t bytes);
+    // 发送积压计数：写入完成时减少（io_context 线程）
+    void SubQueuedBytes(std::size_t bytes);
+    // 发送积压回落至低水位以下（io_context 线程），子类在此恢复读取
+    virtual void OnSendResumed() {}
+    // 套接字已关闭（io_context 线程），子类在此唤醒等待中的读循环
+    virtual void OnClosed() {}
 
-    // 此会话的唯一标识
-    std::string _uuid;
+    // 登记至所在 io_context 的空闲检测时间轮，子类在 Start 中调用
+    void StartIdleCheck();
+
+    // 当前线程是否正在运行本会话的 io_context
+    bool IsInIoThread() const { return this->_ioc.get_executor().running_in_this_thread(); }
+    // 记录对端请求的帧标志，用于主动推送时选择编码
+    void UpdatePeerFlags(const MessageHeader &header) { this->_peerFlags = header.GetFlags(); }
+    // 按服务策略压缩消息体至 out（对端需声明可接收压缩），压缩后设置压缩标志并返回 true
+    bool TryCompress(MessageHeader &header, const char *data, std::size_t len, std::string &out);
+    // 将超过单帧上限的消息体切分为多个分片发送，holder 保证全部分片发送完成前内存有效
+    void SendChunks(const MessageHeader &header, std::shared_ptr<const void> holder, const char *body, std::size_t len, bool compress, bool push);
+    // 完整帧分发前的预处理：记录对端帧标志、解压压缩帧，帧无效时返回 false
+    bool PrepareInbound(std::shared_ptr<MsgNode> &msg);
+    // 分片重组：消息完整时返回 true（msg 为完整消息），分片未收齐或超出预算（关闭会话）时返回 false
+    bool AssembleInbound(std::shared_ptr<MsgNode> &msg);
+
+    // 此会话的唯一标识（日志中使用 FormatSessionId 输出）
+    SessionId _id;
     // 由哪个上下文管理
     boost::asio::io_context &_ioc;
     // 由哪个服务管理
     CServer *_server;
     // 处理连接信息
     boost::asio::ip::tcp::socket _socket;
-    // 互斥量 用于发送队列的多线程保护
-    std::mutex _mutex;
     // 接收到的信息节点
     std::shared_ptr<MsgNode> _recvNode;
-    // 发送队列
-    std::queue<std::shared_ptr<MsgNode>> _sendQue;
+    // 无锁发送队列：任意线程入队，io_context 线程批量取出
+    MpscQueue<std::shared_ptr<SendNode>> _sendInbox;
+    // 写入方是否已被唤醒（已投递 DrainInbox 尚未结束），为 false 时入队方负责投递一次
+    std::atomic<bool> _writeArmed{false};
+    // 溢出队列：无锁队列已满时入队的帧（任意线程，加锁访问），由 PullInbox 在无锁队列之后取出
+    std::mutex _overflowMutex;
+    std::deque<std::shared_ptr<SendNode>> _sendOverflow;
+    // 溢出队列是否非空，非空期间生产者不再写入无锁队列
+    std::atomic<bool> _sendOverflowing{false};
+    // 尚未写出的字节数（含无锁队列、顺序释放槽位及发送队列中的帧）
+    std::atomic<std::size_t> _queuedBytes{0};
+    // 发送积压超过高水位，读取暂停中
+    std::atomic<bool> _sendBlocked{false};
+    // 发送队列（仅在 io_context 线程访问）
+    std::deque<std::shared_ptr<SendNode>> _sendQue;
+    // 控制消息发送队列（如心跳响应），每轮合并写先取此队列，不排在普通消息之后（仅在 io_context 线程访问）
+    std::deque<std::shared_ptr<SendNode>> _controlQue;
+    // 当前正在写入（合并写）的帧数，写入完成后从队首移除
+    std::size_t _writingCount = 0;
+    // 其中取自控制消息发送队列的帧数
+    std::size_t _writingControl = 0;
+    // 已写出的普通消息停在分片中间（最后写出的帧带 HEADER_FLAG_MORE），写完该消息前不插入控制消息
+    bool _bulkInMessage = false;
+    // 合并写的缓冲序列（仅由写入方访问，复用容量）
+    std::vector<boost::asio::const_buffer> _writeBufs;
+
+    // 顺序释放的请求槽位
+    struct OrderSlot
+    {
+        // 请求的消息键 (serviceId, cmdId, seq)
+        uint64_t key;
+        // 请求是否已处理完成
+        bool done;
+        // 尚未轮到发送的响应
+        std::vector<std::shared_ptr<SendNode>> pending;
+    };
+    // 按请求到达顺序排列的槽位，队首请求的响应直接发送（仅在 io_context 线程访问）
+    std::deque<OrderSlot> _orderSlots;
     // 原子类型标志变量，确保线程安全，表示此会话关闭
     std::atomic<bool> _bStop;
+    // 对端最近一次请求携带的帧标志
+    std::atomic<uint16_t> _peerFlags{0};
+    // 分片重组器（仅由读取方访问）
+    ChunkAssembler _assembler;
+    // 所在 io_context 的空闲检测时间轮（未启用时为空）
+    IdleWheel *_idleWheel;
+    // 最近一次活动的 tick
+    uint64_t _idleTick = 0;
     // 客户端信息，默认不创建，仅在通信服务中创建
     std::shared_ptr<ClientInfo> _clientInfo;
+    // 客户端名称，仅在通信服务中设置
+    std::string _clientName;
 };
 
 #endif // CSESSION_H
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "IdleWheel.h"
+
+#include <algorithm>
+
+#include "CSession.h"
+
+IdleWheel::IdleWheel(boost::asio::io_context &ioc, std::chrono::milliseconds tick, std::chrono::milliseconds timeout)
+    : _ioc(ioc),
+      _timer(ioc),
+      _tick(std::max<std::chrono::milliseconds>(tick, std::chrono::milliseconds(1)))
+{
+    // 超时向上取整为 tick 数
+    this->_timeoutTicks = std::max<uint64_t>((timeout.count() + this->_tick.count() - 1) / this->_tick.count(), 1);
+
+    // 桶数需大于超时 tick 数，保证重新放入时不会绕回当前桶
+    std::size_t size = 2;
+    while (size <= this->_timeoutTicks)
+        size <<= 1;
+    this->_mask = size - 1;
+    this->_buckets.resize(size);
+}
+
+void IdleWheel::Start()
+{
+    this->_timer.expires_after(this->_tick);
+    this->_timer.async_wait([this](const boost::system::error_code &error)
+                            {
+                                if (error || this->_stopped)
+                                    return;
+                                OnTick();
+                                Start(); });
+}
+
+void IdleWheel::Stop()
+{
+    boost::asio::post(this->_ioc, [this]()
+                      {
+                          this->_stopped = true;
+                          this->_timer.cancel();
+                          for (auto &bucket : this->_buckets)
+                          {
+                              bucket.clear();
+                          } });
+}
+
+void IdleWheel::Add(std::shared_ptr<CSession> session)
+{
+    boost::asio::post(this->_ioc, [this, session = std::move(session)]()
+                      {
+                          if (this->_stopped)
+                              return;
+                          session->TouchIdle();
+                          Schedule(session, this->_now + this->_timeoutTicks); });
+}
+
+void IdleWheel::OnTick()
+{
+    ++this->_now;
+
+    // 取出当前桶（回调中可能重新放入其他桶）
+    this->_expiring.clear();
+    this->_expiring.swap(this->_buckets[this->_now & this->_mask]);
+
+    for (auto &weak : this->_expiring)
+    {
+        auto session = weak.lock();
+        // 会话已销毁或已关闭，丢弃
+        if (!session || session->IsClosed())
+            continue;
+
+        // 读取因背压暂停：对端的数据（含心跳）滞留在内核缓冲区，不能视为空闲，从现在起重新计时
+        if (session->IsReadPaused())
+        {
+            session->TouchIdle();
+        }
+
+        auto deadline = session->GetIdleTick() + this->_timeoutTicks;
+        if (deadline <= this->_now)
+        {
+            session->OnIdleTimeout();
+            continue;
+        }
+
+        // 期间有活动，按新的到期 tick 重新放入
+        Schedule(std::move(weak), deadline);
+    }
+    this->_expiring.clear();
+}
+
+void IdleWheel::Schedule(std::weak_ptr<CSession> session, uint64_t deadline)
+{
+    this->_buckets[deadline & this->_mask].push_back(std::move(session));
+}
@@ -0,0 +1,64 @@
+#ifndef IDLEWHEEL_H
+#define IDLEWHEEL_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <boost/asio.hpp>
+
+// 前置声明
+class CSession;
+
+// 空闲连接检测时间轮（每个 io_context 一个，仅在该 io_context 线程中访问）
+// 桶数为 2 的幂，会话按到期 tick 散列到桶中；会话活跃时只更新自身的最近活跃 tick，不移动位置，
+// 轮到所在桶时再检查：已超时则关闭，否则按新的到期 tick 重新放入对应的桶
+// 每个连接在一个超时周期内至多被检查一次，整个 io_context 只需一个定时器
+// 读取、写出完成均视为活动；读取因背压暂停的会话不会超时
+class IdleWheel
+{
+public:
+    // 构造函数 tick 为检查粒度，timeout 为空闲超时时间
+    IdleWheel(boost::asio::io_context &ioc, std::chrono::milliseconds tick, std::chrono::milliseconds timeout);
+    // 删除拷贝构造函数
+    IdleWheel(const IdleWheel &) = delete;
+    // 删除赋值构造函数
+    IdleWheel &operator=(const IdleWheel &) = delete;
+
+    // 启动定时器
+    void Start();
+    // 停止定时器并释放所有登记（投递至 io_context 线程执行）
+    void Stop();
+
+    // 登记会话（可在任意线程调用，投递至 io_context 线程执行）
+    void Add(std::shared_ptr<CSession> session);
+    // 当前 tick（io_context 线程）
+    uint64_t Now() const { return this->_now; }
+
+private:
+    // 定时器回调：前进一个 tick，处理当前桶
+    void OnTick();
+    // 放入到期 tick 对应的桶
+    void Schedule(std::weak_ptr<CSession> session, uint64_t deadline);
+
+    // 所属 io_context
+    boost::asio::io_context &_ioc;
+    // tick 定时器
+    boost::asio::steady_timer _timer;
+    // tick 粒度
+    std::chrono::milliseconds _tick;
+    // 超时时长（tick 数）
+    uint64_t _timeoutTicks;
+    // 当前 tick
+    uint64_t _now = 0;
+    // 桶下标掩码
+    uint64_t _mask;
+    // 时间轮的桶：会话弱引用，会话销毁后在轮到时丢弃
+    std::vector<std::vector<std::weak_ptr<CSession>>> _buckets;
+    // 处理当前桶时复用的缓冲区
+    std::vector<std::weak_ptr<CSession>> _expiring;
+    // 是否已停止
+    bool _stopped = false;
+};
+
+#endif // IDLEWHEEL_H
@@ -0,0 +1,54 @@
+#include "SessionId.h"
+
+#include <cstdio>
+
+std::string FormatSessionId(SessionId id)
+{
+    char buf[17];
+    std::snprintf(buf, sizeof(buf), "%016llx", static_cast<unsigned long long>(id));
+    return std::string(buf, 16);
+}
+
+SessionIdAllocator &SessionIdAllocator::GetInstance()
+{
+    static SessionIdAllocator instance;
+    return instance;
+}
+
+SessionId SessionIdAllocator::Allocate()
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    uint32_t slot;
+    if (!this->_freeSlots.empty())
+    {
+        // 复用空闲槽位（代数已在归还时递增）
+        slot = this->_freeSlots.back();
+        this->_freeSlots.pop_back();
+    }
+    else
+    {
+        // 新槽位，代数从 1 开始
+        slot = static_cast<uint32_t>(this->_generations.size());
+        this->_generations.push_back(1);
+    }
+
+    return (static_cast<SessionId>(this->_generations[slot]) << 32) | slot;
+}
+
+void SessionIdAllocator::Release(SessionId id)
+{
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    auto slot = GetSlot(id);
+    // 防止重复归还或归还过期标识
+    if (slot >= this->_generations.size() || this->_generations[slot] != GetGeneration(id))
+        return;
+
+    // 递增代数（跳过 0，保证有效 ID 不为 INVALID_SESSION_ID），旧 ID 随即失效
+    if (++this->_generations[slot] == 0)
+    {
+        this->_generations[slot] = 1;
+    }
+    this->_freeSlots.push_back(slot);
+}
@@ -0,0 +1,51 @@
+#ifndef SESSIONID_H
+#define SESSIONID_H
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// 会话标识：高 32 位为代数（generation），低 32 位为槽位（slot）
+// 槽位在会话销毁后复用，代数每次分配递增，因此持有旧 ID 的一方（如转发目标）不会误命中新会话
+using SessionId = uint64_t;
+
+// 无效的会话标识（代数从 1 开始，有效 ID 不为 0）
+constexpr SessionId INVALID_SESSION_ID = 0;
+
+// 会话标识的字符串形式（16 位十六进制），仅用于日志输出
+std::string FormatSessionId(SessionId id);
+
+// 会话标识分配器
+class SessionIdAllocator
+{
+public:
+    // 删除拷贝构造函数
+    SessionIdAllocator(const SessionIdAllocator &) = delete;
+    // 删除赋值构造函数
+    SessionIdAllocator &operator=(const SessionIdAllocator &) = delete;
+
+    // 单例
+    static SessionIdAllocator &GetInstance();
+
+    // 分配标识：优先复用空闲槽位
+    SessionId Allocate();
+    // 归还标识（会话销毁时调用）：递增该槽位的代数后放回空闲列表，代数不匹配时忽略
+    void Release(SessionId id);
+
+    // 获取槽位 / 代数
+    static uint32_t GetSlot(SessionId id) { return static_cast<uint32_t>(id); }
+    static uint32_t GetGeneration(SessionId id) { return static_cast<uint32_t>(id >> 32); }
+
+private:
+    SessionIdAllocator() = default;
+
+    // 各槽位当前（或下一次分配）的代数
+    std::vector<uint32_t> _generations;
+    // 空闲槽位
+    std::vector<uint32_t> _freeSlots;
+    // 分配与归还仅在建立 / 销毁连接时发生，使用互斥锁即可
+    std::mutex _mutex;
+};
+
+#endif // SESSIONID_H
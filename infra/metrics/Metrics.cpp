@@ -0,0 +1,158 @@
+#include "Metrics.h"
+
+#include "../log/Logger.h"
+#include "../../core/message/BufferPool.h"
+
+Metrics &Metrics::GetInstance()
+{
+    static Metrics instance;
+    return instance;
+}
+
+void Metrics::RecordWrite(std::size_t frames, std::size_t bytes)
+{
+    this->_writeCalls.fetch_add(1, std::memory_order_relaxed);
+    this->_framesWritten.fetch_add(frames, std::memory_order_relaxed);
+    this->_bytesWritten.fetch_add(bytes, std::memory_order_relaxed);
+    UpdateMax(this->_maxFramesPerWrite, frames);
+}
+
+void Metrics::RecordCompress(std::size_t inBytes, std::size_t outBytes, uint64_t nanos)
+{
+    this->_compressCount.fetch_add(1, std::memory_order_relaxed);
+    this->_compressIn.fetch_add(inBytes, std::memory_order_relaxed);
+    this->_compressOut.fetch_add(outBytes, std::memory_order_relaxed);
+    this->_compressNanos.fetch_add(nanos, std::memory_order_relaxed);
+}
+
+void Metrics::RecordDecompress(std::size_t inBytes, std::size_t outBytes, uint64_t nanos)
+{
+    this->_decompressCount.fetch_add(1, std::memory_order_relaxed);
+    this->_decompressIn.fetch_add(inBytes, std::memory_order_relaxed);
+    this->_decompressOut.fetch_add(outBytes, std::memory_order_relaxed);
+    this->_decompressNanos.fetch_add(nanos, std::memory_order_relaxed);
+}
+
+void Metrics::RecordReadPause()
+{
+    this->_readPauses.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::RecordSlowConsumer()
+{
+    this->_slowConsumers.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::RecordLogicEnqueue()
+{
+    auto depth = this->_logicDepth.fetch_add(1, std::memory_order_relaxed) + 1;
+    UpdateMax(this->_logicMaxDepth, depth);
+}
+
+void Metrics::RecordLogicBatch(std::size_t count, uint64_t totalWaitNanos, uint64_t maxWaitNanos)
+{
+    this->_logicDepth.fetch_sub(count, std::memory_order_relaxed);
+    this->_logicMsgs.fetch_add(count, std::memory_order_relaxed);
+    this->_logicBatches.fetch_add(1, std::memory_order_relaxed);
+    this->_logicWaitNanos.fetch_add(totalWaitNanos, std::memory_order_relaxed);
+    UpdateMax(this->_logicMaxWaitNanos, maxWaitNanos);
+}
+
+void Metrics::RecordComputeTask()
+{
+    this->_computeTasks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::RecordComputeSteal()
+{
+    this->_computeSteals.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::RecordAccept()
+{
+    this->_accepts.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::RecordAcceptBackoff()
+{
+    this->_acceptBackoffs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::UpdateMax(std::atomic<uint64_t> &target, uint64_t value)
+{
+    auto current = target.load(std::memory_order_relaxed);
+    while (current < value && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+void Metrics::LogSnapshot() const
+{
+    auto writes = this->_writeCalls.load(std::memory_order_relaxed);
+    auto frames = this->_framesWritten.load(std::memory_order_relaxed);
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(2);
+
+    // 发送：合并写效果
+    oss << "Metrics [write] calls=" << writes
+        << ", frames=" << frames
+        << ", bytes=" << this->_bytesWritten.load(std::memory_order_relaxed)
+        << ", frames/write=" << (writes > 0 ? static_cast<double>(frames) / writes : 0.0)
+        << ", maxFrames/write=" << this->_maxFramesPerWrite.load(std::memory_order_relaxed)
+        << ", readPauses=" << this->_readPauses.load(std::memory_order_relaxed)
+        << ", slowConsumers=" << this->_slowConsumers.load(std::memory_order_relaxed);
+    LOG_INFO << oss.str() << std::endl;
+
+    // 逻辑系统：队列深度、批量大小及排队时长
+    auto logicMsgs = this->_logicMsgs.load(std::memory_order_relaxed);
+    auto logicBatches = this->_logicBatches.load(std::memory_order_relaxed);
+    oss.str("");
+    oss << "Metrics [logic] msgs=" << logicMsgs
+        << ", batches=" << logicBatches
+        << ", msgs/batch=" << (logicBatches > 0 ? static_cast<double>(logicMsgs) / logicBatches : 0.0)
+        << ", depth=" << this->_logicDepth.load(std::memory_order_relaxed)
+        << ", maxDepth=" << this->_logicMaxDepth.load(std::memory_order_relaxed)
+        << ", avgWaitUs=" << (logicMsgs > 0 ? this->_logicWaitNanos.load(std::memory_order_relaxed) / 1000.0 / logicMsgs : 0.0)
+        << ", maxWaitUs=" << this->_logicMaxWaitNanos.load(std::memory_order_relaxed) / 1000.0;
+    LOG_INFO << oss.str() << std::endl;
+
+    // 计算线程池：任务数及窃取数
+    oss.str("");
+    oss << "Metrics [compute] tasks=" << this->_computeTasks.load(std::memory_order_relaxed)
+        << ", steals=" << this->_computeSteals.load(std::memory_order_relaxed);
+    LOG_INFO << oss.str() << std::endl;
+
+    // 连接：接收数及退避次数
+    oss.str("");
+    oss << "Metrics [accept] accepts=" << this->_accepts.load(std::memory_order_relaxed)
+        << ", backoffs=" << this->_acceptBackoffs.load(std::memory_order_relaxed);
+    LOG_INFO << oss.str() << std::endl;
+
+    // 压缩：压缩率（压缩后 / 压缩前）及平均耗时
+    auto compressCount = this->_compressCount.load(std::memory_order_relaxed);
+    auto compressIn = this->_compressIn.load(std::memory_order_relaxed);
+    auto compressOut = this->_compressOut.load(std::memory_order_relaxed);
+    auto decompressCount = this->_decompressCount.load(std::memory_order_relaxed);
+    auto decompressIn = this->_decompressIn.load(std::memory_order_relaxed);
+    auto decompressOut = this->_decompressOut.load(std::memory_order_relaxed);
+    oss.str("");
+    oss << "Metrics [compress] count=" << compressCount
+        << ", in=" << compressIn
+        << ", out=" << compressOut
+        << ", ratio=" << (compressIn > 0 ? static_cast<double>(compressOut) / compressIn : 0.0)
+        << ", avgUs=" << (compressCount > 0 ? this->_compressNanos.load(std::memory_order_relaxed) / 1000.0 / compressCount : 0.0)
+        << " [decompress] count=" << decompressCount
+        << ", in=" << decompressIn
+        << ", out=" << decompressOut
+        << ", ratio=" << (decompressOut > 0 ? static_cast<double>(decompressIn) / decompressOut : 0.0)
+        << ", avgUs=" << (decompressCount > 0 ? this->_decompressNanos.load(std::memory_order_relaxed) / 1000.0 / decompressCount : 0.0);
+    LOG_INFO << oss.str() << std::endl;
+
+    // 内存池命中情况
+    auto pool = BufferPool::GetInstance().GetStats();
+    LOG_INFO << "Metrics [pool] localHits=" << pool.localHits
+             << ", globalHits=" << pool.globalHits
+             << ", misses=" << pool.misses
+             << ", oversize=" << pool.oversize << std::endl;
+}
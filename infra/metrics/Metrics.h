@@ -0,0 +1,90 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 服务器运行指标（全局计数器，线程安全），定期输出至日志
+class Metrics
+{
+public:
+    // 删除拷贝构造函数
+    Metrics(const Metrics &) = delete;
+    // 删除赋值构造函数
+    Metrics &operator=(const Metrics &) = delete;
+
+    // 单例
+    static Metrics &GetInstance();
+
+    // 记录一次合并写：本次写入的帧数与字节数
+    void RecordWrite(std::size_t frames, std::size_t bytes);
+
+    // 记录一次压缩 / 解压：输入字节数、输出字节数、耗时（纳秒）
+    void RecordCompress(std::size_t inBytes, std::size_t outBytes, uint64_t nanos);
+    void RecordDecompress(std::size_t inBytes, std::size_t outBytes, uint64_t nanos);
+
+    // 记录一次因发送积压而暂停读取
+    void RecordReadPause();
+    // 记录一次因发送积压超过硬上限而断开的慢消费者
+    void RecordSlowConsumer();
+
+    // 记录一条投递至 LogicSystem 的消息
+    void RecordLogicEnqueue();
+    // 记录 LogicSystem 一次批量取出：消息数、累计排队时长及最大排队时长（纳秒）
+    void RecordLogicBatch(std::size_t count, uint64_t totalWaitNanos, uint64_t maxWaitNanos);
+
+    // 记录计算线程池执行的一个任务 / 一次窃取
+    void RecordComputeTask();
+    void RecordComputeSteal();
+
+    // 记录一次成功接收的连接
+    void RecordAccept();
+    // 记录一次因文件描述符耗尽而退避的接收
+    void RecordAcceptBackoff();
+
+    // 输出当前指标快照
+    void LogSnapshot() const;
+
+private:
+    Metrics() = default;
+
+    // 以 CAS 方式更新最大值
+    static void UpdateMax(std::atomic<uint64_t> &target, uint64_t value);
+
+    // 发送相关
+    std::atomic<uint64_t> _writeCalls{0};        // async_write 次数
+    std::atomic<uint64_t> _framesWritten{0};     // 已写出的帧数
+    std::atomic<uint64_t> _bytesWritten{0};      // 已写出的字节数
+    std::atomic<uint64_t> _maxFramesPerWrite{0}; // 单次写入的最大帧数
+    std::atomic<uint64_t> _readPauses{0};        // 因发送积压暂停读取的次数
+    std::atomic<uint64_t> _slowConsumers{0};     // 因发送积压断开的连接数
+
+    // 逻辑系统相关
+    std::atomic<uint64_t> _logicDepth{0};        // 当前排队的消息数
+    std::atomic<uint64_t> _logicMaxDepth{0};     // 最大排队消息数
+    std::atomic<uint64_t> _logicMsgs{0};         // 已取出的消息数
+    std::atomic<uint64_t> _logicBatches{0};      // 批量取出次数
+    std::atomic<uint64_t> _logicWaitNanos{0};    // 累计排队时长
+    std::atomic<uint64_t> _logicMaxWaitNanos{0}; // 最大排队时长
+
+    // 计算线程池相关
+    std::atomic<uint64_t> _computeTasks{0};      // 执行的任务数
+    std::atomic<uint64_t> _computeSteals{0};     // 窃取的任务数
+
+    // 连接相关
+    std::atomic<uint64_t> _accepts{0};           // 接收的连接数
+    std::atomic<uint64_t> _acceptBackoffs{0};    // 接收退避次数
+
+    // 压缩相关
+    std::atomic<uint64_t> _compressCount{0};     // 压缩次数
+    std::atomic<uint64_t> _compressIn{0};        // 压缩前字节数
+    std::atomic<uint64_t> _compressOut{0};       // 压缩后字节数
+    std::atomic<uint64_t> _compressNanos{0};     // 压缩耗时
+    std::atomic<uint64_t> _decompressCount{0};   // 解压次数
+    std::atomic<uint64_t> _decompressIn{0};      // 解压前字节数
+    std::atomic<uint64_t> _decompressOut{0};     // 解压后字节数
+    std::atomic<uint64_t> _decompressNanos{0};   // 解压耗时
+};
+
+#endif // METRICS_H
@@ -0,0 +1,129 @@
+#include "CpuTopology.h"
+
+#include <filesystem>
+#include <fstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace util
+{
+
+    int GetCpuLimit()
+    {
+#ifdef __linux__
+        long count = sysconf(_SC_NPROCESSORS_CONF);
+        if (count <= 0 || count > CPU_SETSIZE)
+            count = CPU_SETSIZE;
+        return static_cast<int>(count);
+#else
+        return 0;
+#endif
+    }
+
+    std::vector<int> ParseCpuList(const std::string &list, std::vector<std::string> &invalid)
+    {
+        std::vector<int> cpus;
+        int limit = GetCpuLimit();
+        std::size_t pos = 0;
+        while (pos < list.size())
+        {
+            auto end = list.find(',', pos);
+            if (end == std::string::npos)
+                end = list.size();
+            auto item = list.substr(pos, end - pos);
+            pos = end + 1;
+
+            if (item.empty())
+                continue;
+
+            try
+            {
+                // 单个编号视为首尾相同的区间（负数首位的 '-' 不作为区间分隔符，按无效编号处理）
+                auto dash = item.find('-', 1);
+                int first = std::stoi(item.substr(0, dash));
+                int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+
+                // 编号须在 [0, limit) 内（CPU_SET 对越界编号无定义），整项跳过，不展开超大区间
+                if (first < 0 || last < first || last >= limit)
+                {
+                    invalid.push_back(item);
+                    continue;
+                }
+
+                for (int cpu = first; cpu <= last; ++cpu)
+                {
+                    cpus.push_back(cpu);
+                }
+            }
+            catch (const std::exception &)
+            {
+                // 格式错误的项
+                invalid.push_back(item);
+            }
+        }
+        return cpus;
+    }
+
+    int GetCpuNode(int cpu)
+    {
+#ifdef __linux__
+        // /sys/devices/system/cpu/cpuN/ 下存在 nodeM 目录（链接）表示该 CPU 属于节点 M
+        std::error_code ec;
+        fs::path dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+        for (auto &entry : fs::directory_iterator(dir, ec))
+        {
+            auto name = entry.path().filename().string();
+            if (name.size() > 4 && name.compare(0, 4, "node") == 0)
+            {
+                try
+                {
+                    return std::stoi(name.substr(4));
+                }
+                catch (const std::exception &)
+                {
+                }
+            }
+        }
+#else
+        (void)cpu;
+#endif
+        return -1;
+    }
+
+    int GetNetDeviceNode(const std::string &name)
+    {
+#ifdef __linux__
+        // 虚拟网卡或单节点机器上为 -1 或不存在
+        std::ifstream file("/sys/class/net/" + name + "/device/numa_node");
+        int node = -1;
+        if (file >> node)
+            return node;
+#else
+        (void)name;
+#endif
+        return -1;
+    }
+
+    bool PinCurrentThread(int cpu)
+    {
+#ifdef __linux__
+        if (cpu < 0 || cpu >= CPU_SETSIZE)
+            return false;
+
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+        (void)cpu;
+        return false;
+#endif
+    }
+
+}
@@ -0,0 +1,22 @@
+#ifndef CPUTOPOLOGY_H
+#define CPUTOPOLOGY_H
+
+#include <string>
+#include <vector>
+
+// CPU 拓扑与线程亲和性（Linux 下读取 sysfs，其他平台返回未知 / 失败）
+namespace util
+{
+    // 获取 CPU 编号上限：有效编号为 [0, 上限)，即已配置的 CPU 数（不超过 CPU_SETSIZE）
+    int GetCpuLimit();
+    // 解析 CPU 列表，如 "0-3,8,10-11"，格式错误或超出 [0, GetCpuLimit()) 的项跳过并放入 invalid
+    std::vector<int> ParseCpuList(const std::string &list, std::vector<std::string> &invalid);
+    // 获取 CPU 所在的 NUMA 节点，未知时返回 -1
+    int GetCpuNode(int cpu);
+    // 获取网卡所在的 NUMA 节点（/sys/class/net/<name>/device/numa_node），未知时返回 -1
+    int GetNetDeviceNode(const std::string &name);
+    // 将当前线程绑定到指定 CPU，编号无效或失败时返回 false
+    bool PinCurrentThread(int cpu);
+}
+
+#endif // CPUTOPOLOGY_H
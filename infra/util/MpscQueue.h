@@ -0,0 +1,121 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// 有界无锁队列（多生产者 / 单消费者）
+// 基于 Dmitry Vyukov 的有界 MPMC 队列：每个槽位带序号，生产者通过 CAS 抢占写入位置，
+// 消费者只有一个，读取位置无需原子操作
+// 容量向上取整为 2 的幂；元素类型需可默认构造、可移动（出队后槽位中的元素被移走）
+template <typename T>
+class MpscQueue
+{
+public:
+    // 显式构造函数，指定容量（向上取整为 2 的幂）
+    explicit MpscQueue(std::size_t capacity)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+
+        this->_mask = size - 1;
+        this->_cells = std::make_unique<Cell[]>(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            this->_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // 删除拷贝构造函数
+    MpscQueue(const MpscQueue &) = delete;
+    // 删除赋值构造函数
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    // 生产者入队（任意线程），队列已满时返回 false
+    bool TryPush(T value)
+    {
+        Cell *cell;
+        std::size_t pos = this->_enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            cell = &this->_cells[pos & this->_mask];
+            std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+            // 槽位空闲，抢占写入位置
+            if (diff == 0)
+            {
+                if (this->_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            // 槽位尚未被消费者取走，队列已满
+            else if (diff < 0)
+            {
+                return false;
+            }
+            // 其他生产者已抢占，重新读取写入位置
+            else
+            {
+                pos = this->_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        // 发布：消费者看到序号后即可读取
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 消费者出队（仅限单个线程），队列为空时返回 false
+    bool TryPop(T &value)
+    {
+        Cell *cell = &this->_cells[this->_dequeuePos & this->_mask];
+        std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+
+        // 槽位尚未写入完成
+        if (seq != this->_dequeuePos + 1)
+            return false;
+
+        value = std::move(cell->value);
+        cell->value = T();
+        // 归还槽位，供下一轮生产者写入
+        cell->sequence.store(this->_dequeuePos + this->_mask + 1, std::memory_order_release);
+        ++this->_dequeuePos;
+        return true;
+    }
+
+    // 队列是否为空（仅限消费者线程调用）
+    bool Empty() const
+    {
+        const Cell *cell = &this->_cells[this->_dequeuePos & this->_mask];
+        return cell->sequence.load(std::memory_order_acquire) != this->_dequeuePos + 1;
+    }
+
+    // 队列是否为空，且没有生产者正在写入（仅限消费者线程调用）
+    bool Idle() const { return this->_enqueuePos.load(std::memory_order_acquire) == this->_dequeuePos; }
+
+    // 获取容量
+    std::size_t Capacity() const { return this->_mask + 1; }
+
+private:
+    // 槽位
+    struct Cell
+    {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    // 槽位数组
+    std::unique_ptr<Cell[]> _cells;
+    // 下标掩码（容量 - 1）
+    std::size_t _mask;
+    // 生产者写入位置（独占缓存行，避免与消费者伪共享）
+    alignas(64) std::atomic<std::size_t> _enqueuePos{0};
+    // 消费者读取位置
+    alignas(64) std::size_t _dequeuePos = 0;
+};
+
+#endif // MPSC_QUEUE_H
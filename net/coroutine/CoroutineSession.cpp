@@ -5,59 +5,36 @@
 
 #include "../../services/ServiceManager.h"
 #include "../../services/IService.h"
+#include "../../core/logic/DispatchScheduler.h"
+#include "../../core/protocol/JsonResponse.h"
 
 #include "../../infra/log/Logger.h"
+#include "../../config/ConfigManager.h"
 #include "../../infra/util/StringFormat.h"
 
 #include "../../core/common/Const.h" // 获取心跳服务ID
 
 CoroutineSession::CoroutineSession(boost::asio::io_context &ioc, boost::asio::ip::tcp::socket socket, CServer *server)
     : CSession(ioc, std::move(socket), server),
-      _deadline(ioc) // 初始化定时器
+      _recvBuffer(RECV_BUFFER_SIZE, ConfigManager::GetInstance().GetMaxFrameSize()),
+      _windowTimer(ioc),
+      _window(ConfigManager::GetInstance().GetPipelineWindow()),
+      _inflight(0),
+      _controlInflight(0),
+      _lanePendingBytes(0)
 {
-    // 初始化最后活动时间
-    _last_message_time = std::chrono::steady_clock::now();
 }
 
 CoroutineSession::~CoroutineSession()
 {
     // 取消定时器
-    _deadline.cancel();
-}
-
-// 新增：心跳检测协程
-void CoroutineSession::StartHeartbeatCheck()
-{
-    // 设置超时时间，例如 60 秒无数据则断开
-    auto self = shared_from_this();
-    boost::asio::co_spawn(_ioc, [self, this]() -> boost::asio::awaitable<void>
-                          {
-        while (!_bStop) {
-            // 设置定时器等待 5 秒检查一次
-            _deadline.expires_after(std::chrono::seconds(5));
-            boost::system::error_code ec;
-            co_await _deadline.async_wait(redirect_error(boost::asio::use_awaitable, ec));
-
-            if (_bStop) co_return;
-
-            // 检查距离上次收到消息是否超过 60 秒
-            auto now = std::chrono::steady_clock::now();
-            auto duration = std::chrono::duration_cast<std::chrono::seconds>(now - _last_message_time).count();
-
-            if (duration > 60)
-            {
-                LOG_WARN << "Client heartbeat timeout! Force Close. UUID: " << GetUuid() << std::endl;
-                Close();
-                _server->DelSessionByUuid(_uuid);
-                co_return;
-            }
-        } }, boost::asio::detached);
+    _windowTimer.cancel();
 }
 
 void CoroutineSession::Start()
 {
-    // 1. 启动看门狗
-    StartHeartbeatCheck();
+    // 1. 登记空闲检测
+    StartIdleCheck();
 
     // 开启协程
     boost::asio::co_spawn(this->_ioc, [this]() -> boost::asio::awaitable<void>
@@ -66,82 +43,52 @@ void CoroutineSession::Start()
                  {
                     for (; !this->_bStop; )
                     {
-                        // 重置消息节点
-                        this->_recvNode->Clear();
-                        // 开始读取头部信息
-                        std::size_t len = co_await boost::asio::async_read(this->_socket, boost::asio::buffer(this->_recvNode->GetHeaderData(), MsgNode::GetHeaderSize()), boost::asio::use_awaitable);
+                        // 在途请求达到窗口上限，或发送积压超过高水位：暂停解析与读取（TCP 背压），
+                        // 等待请求完成或积压回落至低水位后唤醒
+                        while ((this->_inflight >= this->_window || IsSendBlocked()) && !this->_bStop)
+                        {
+                            this->_windowTimer.expires_at(boost::asio::steady_timer::time_point::max());
+                            boost::system::error_code ec;
+                            co_await this->_windowTimer.async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+                        }
 
-                        // 更新最后活动时间（喂狗）
-                        this->_last_message_time = std::chrono::steady_clock::now();
-                        if (len == 0)
+                        // 分发缓冲区中所有完整的消息帧（窗口占满时剩余的帧留待下一轮）
+                        while (this->_inflight < this->_window)
                         {
-                            LOG_ERROR << "CoroutineSession: Client Close a Connect." << std::endl;
+                            auto msg = this->_recvBuffer.PopFrame();
+                            if (!msg)
+                                break;
+                            DispatchMsg(std::move(msg));
+                        }
+
+                        // 帧长度超过上限（可能是伪造的 Header），断开连接
+                        if (this->_recvBuffer.IsFrameTooLarge())
+                        {
+                            LOG_WARN << "CoroutineSession: Frame too large, close " << FormatSessionId(this->_id) << std::endl;
                             Close();
-                            this->_server->DelSessionByUuid(this->_uuid);
+                            this->_server->DelSessionById(this->_id);
                             co_return;
                         }
 
-                        // 转为本地主机字节序 必须转换！！！
-                        this->_recvNode->GetHeader().ToHost();
+                        // 窗口已满，先等待再读取
+                        if (this->_inflight >= this->_window)
+                            continue;
 
-                        // 获取消息长度
-                        auto length = this->_recvNode->GetHeader().length;
+                        // 批量读取：一次 async_read_some 可能带回多个完整帧
+                        std::size_t len = co_await this->_socket.async_read_some(this->_recvBuffer.PrepareWrite(), boost::asio::use_awaitable);
 
-                        // 为消息节点分配内存
-                        this->_recvNode->Allocate(length);
-                        
-                        // 如果消息长度大于 0，则开始读取消息体
-                        if (length > 0)
+                        // 更新最后活动时间（喂狗）
+                        TouchIdle();
+                        if (len == 0)
                         {
-                            // 开始读取消息信息
-                            len = co_await boost::asio::async_read(this->_socket, boost::asio::buffer(this->_recvNode->GetBody(), this->_recvNode->GetBodyLen()), boost::asio::use_awaitable);
-                            // 如果本来想读数据却读到了 0，那才是真正的断开
-                            if (len == 0)
-                            {
-                                LOG_ERROR << "CoroutineSession: Client Close a Connect." << std::endl;
-                                Close();
-                                this->_server->DelSessionByUuid(this->_uuid);
-                                co_return;
-                            }
+                            LOG_ERROR << "CoroutineSession: Client Close a Connect." << std::endl;
+                            Close();
+                            this->_server->DelSessionById(this->_id);
+                            co_return;
                         }
 
-                        // 输出信息
-                        this->_recvNode->Print();
-                        // 获取头部信息，直接分发，避免 LogicSystem 阻塞
-                        auto& header = this->_recvNode->GetHeader();
-
-                        // 1. 查找服务
-                        auto service = ServiceManager::GetInstance().GetServiceById(header.serviceId);
-                        // 如果服务存在
-                        if (service) 
-                        {
-                            // 2. 构造消息，使用移动语义，避免拷贝
-                            auto msg = std::move(this->_recvNode);
-                            // 重新构建消息节点
-                            this->_recvNode = std::make_shared<MsgNode>();
-                            
-                            // 3. 执行业务逻辑
-                            // 选项 A (推荐): 并发处理
-                            // 使用 co_spawn 启动一个新的协程来处理业务。
-                            // 优点：当前读循环可以立即继续，处理下一个包（高吞吐）。
-                            // 缺点：同一个连接的请求可能会乱序完成（如果业务耗时不同）。
-                            // 注意：这里需要传入 shared_from_this() 保持 Session 存活
-                            boost::asio::co_spawn(this->_ioc, 
-                                service->Handle(shared_from_this(), msg), 
-                                boost::asio::detached);
-
-                            /* // 选项 B: 顺序处理
-                            // 使用 co_await 等待业务处理完成。
-                            // 优点：严格保证同一个连接的请求按顺序处理。
-                            // 缺点：如果某个请求处理慢，会阻塞后续包的读取。
-                            
-                            co_await service->Handle(shared_from_this(), msg);
-                            */
-                        }
-                        else
-                        {
-                            LOG_WARN << "Service Not Found: " << header.serviceId << std::endl;
-                        }
+                        // 提交已读取的数据
+                        this->_recvBuffer.Commit(len);
                     }
                  }
                  catch (boost::system::system_error& e)
@@ -155,6 +102,215 @@ void CoroutineSession::Start()
                                 << ConvertStringToUTF8(e.code().message()) << '\n';
                     }
                      Close();
-                     this->_server->DelSessionByUuid(this->_uuid);
+                     this->_server->DelSessionById(this->_id);
                  } }, boost::asio::detached);
 }
+
+void CoroutineSession::DispatchMsg(std::shared_ptr<MsgNode> msg)
+{
+    // 预处理（解压等），无效帧直接丢弃
+    if (!PrepareInbound(msg))
+        return;
+
+    // 获取头部信息，直接分发，避免 LogicSystem 阻塞
+    auto &header = msg->GetHeader();
+
+    // 1. 查找服务
+    auto service = ServiceManager::GetInstance().GetServiceById(header.serviceId);
+    // 如果服务不存在
+    if (!service)
+    {
+        LOG_WARN << "Service Not Found: " << header.serviceId << std::endl;
+        return;
+    }
+
+    // 流式命令：分片不重组，按序逐个交给回调
+    if (service->IsStreamCmd(header.cmdId))
+    {
+        DispatchLane(service, std::move(msg), header.GetMessageKey());
+        return;
+    }
+
+    // 分片重组，消息未收齐时先缓存
+    if (!AssembleInbound(msg))
+        return;
+
+    // 输出信息
+    msg->Print();
+
+    // 控制消息（如心跳）：不登记顺序槽位、不进入串行队列，立即执行
+    // 同时执行的控制消息不超过 MAX_CONTROL_INFLIGHT 时不占用窗口，超出部分计入窗口，避免绕过背压
+    if (ConfigManager::GetInstance().GetPriority(header.serviceId, header.cmdId) == PRIORITY_CONTROL)
+    {
+        if (this->_controlInflight < MAX_CONTROL_INFLIGHT)
+        {
+            ++this->_controlInflight;
+            boost::asio::co_spawn(this->_ioc,
+                                  RunControl(service, std::move(msg)),
+                                  boost::asio::detached);
+        }
+        else
+        {
+            ++this->_inflight;
+            boost::asio::co_spawn(this->_ioc,
+                                  RunHandler(service, std::move(msg), false),
+                                  boost::asio::detached);
+        }
+        return;
+    }
+
+    // 2. 执行业务逻辑，分发模式由服务配置决定
+    // - 并发（原选项 A）：每个请求启动一个协程，读循环立即继续，响应按完成顺序发送（可能乱序）
+    // - 有序：同样并发处理，但响应按请求到达顺序发送（槽位缓存先完成的响应）
+    // - 串行（原选项 B）：同一服务的请求逐个处理，响应同样按到达顺序发送
+    // 在途请求数受窗口限制，窗口占满时读循环暂停读取，形成背压
+    auto mode = ConfigManager::GetInstance().GetDispatchMode(header.serviceId);
+    if (mode != DISPATCH_CONCURRENT && !BeginOrdered(header.GetMessageKey()))
+    {
+        // 同一 (serviceId, cmdId, seq) 的请求尚未完成，响应会被错配：拒绝本次请求，错误以推送方式立即回应（不进入槽位）
+        LOG_WARN << "CoroutineSession: Duplicate in-flight seq " << header.seq << " for cmd " << header.cmdId << " on ordered service " << header.serviceId << ", reject it." << std::endl;
+        Push(header, JsonResponse::Error(header.serviceId, header.cmdId, header.seq, 9998, "duplicate in-flight seq"));
+        return;
+    }
+
+    if (mode == DISPATCH_SERIAL)
+    {
+        DispatchLane(service, std::move(msg), SERIAL_LANE | header.serviceId);
+        return;
+    }
+
+    ++this->_inflight;
+    // 注意：这里需要传入 shared_from_this() 保持 Session 存活
+    boost::asio::co_spawn(this->_ioc,
+                          RunHandler(service, std::move(msg), mode == DISPATCH_ORDERED),
+                          boost::asio::detached);
+}
+
+boost::asio::awaitable<void> CoroutineSession::RunHandler(IService *service, std::shared_ptr<MsgNode> msg, bool ordered)
+{
+    // 保持 Session 存活
+    auto self = shared_from_this();
+    auto key = msg->GetHeader().GetMessageKey();
+
+    try
+    {
+        co_await DispatchScheduler::Dispatch(service, self, std::move(msg));
+    }
+    catch (const std::exception &e)
+    {
+        LOG_ERROR << "CoroutineSession: Handler error: " << e.what() << std::endl;
+    }
+
+    if (ordered)
+    {
+        EndOrdered(key);
+    }
+    ReleaseWindow();
+}
+
+boost::asio::awaitable<void> CoroutineSession::RunControl(IService *service, std::shared_ptr<MsgNode> msg)
+{
+    // 保持 Session 存活
+    auto self = shared_from_this();
+
+    try
+    {
+        co_await DispatchScheduler::Dispatch(service, self, std::move(msg));
+    }
+    catch (const std::exception &e)
+    {
+        LOG_ERROR << "CoroutineSession: Control handler error: " << e.what() << std::endl;
+    }
+
+    --this->_controlInflight;
+}
+
+void CoroutineSession::ReleaseWindow()
+{
+    --this->_inflight;
+    // 唤醒可能因窗口占满而暂停的读循环
+    this->_windowTimer.cancel();
+}
+
+void CoroutineSession::OnSendResumed()
+{
+    // 唤醒因发送积压而暂停的读循环
+    this->_windowTimer.cancel();
+}
+
+void CoroutineSession::OnClosed()
+{
+    // 唤醒暂停中的读循环，读循环检查到 _bStop 后退出
+    this->_windowTimer.cancel();
+}
+
+void CoroutineSession::DispatchLane(IService *service, std::shared_ptr<MsgNode> msg, uint64_t lane)
+{
+    // 队列中未处理的消息同样计入接收预算，回调处理过慢时断开连接
+    this->_lanePendingBytes += msg->GetBodyLen();
+    if (this->_lanePendingBytes > ConfigManager::GetInstance().GetMaxMessageSize())
+    {
+        LOG_WARN << "CoroutineSession: Lane backlog exceeds receive budget, close " << FormatSessionId(this->_id) << std::endl;
+        Close();
+        this->_server->DelSessionById(this->_id);
+        return;
+    }
+
+    // 同一队列的消息按到达顺序处理，每条消息占用一个窗口
+    ++this->_inflight;
+    auto [it, created] = this->_lanes.try_emplace(lane);
+    it->second.push_back(std::move(msg));
+
+    // 已有协程在按序处理该队列
+    if (!created)
+        return;
+
+    boost::asio::co_spawn(this->_ioc,
+                          DrainLane(service, lane),
+                          boost::asio::detached);
+}
+
+boost::asio::awaitable<void> CoroutineSession::DrainLane(IService *service, uint64_t lane)
+{
+    // 保持 Session 存活
+    auto self = shared_from_this();
+    // 串行队列的请求需要按到达顺序释放响应（流式分片不占用槽位）
+    bool ordered = (lane & SERIAL_LANE) != 0;
+
+    // 读循环与本协程运行在同一 io_context（单线程）上，访问 _lanes 无需加锁
+    for (;;)
+    {
+        auto it = this->_lanes.find(lane);
+        if (it == this->_lanes.end())
+            break;
+        // 队列已空，处理结束
+        if (it->second.empty())
+        {
+            this->_lanes.erase(it);
+            break;
+        }
+
+        auto msg = std::move(it->second.front());
+        it->second.pop_front();
+        this->_lanePendingBytes -= msg->GetBodyLen();
+        auto key = msg->GetHeader().GetMessageKey();
+
+        // 等待当前消息处理完成后再处理下一个，保证顺序
+        // 单个消息出错只记录日志，不影响队列中后续的消息
+        try
+        {
+            co_await DispatchScheduler::Dispatch(service, self, std::move(msg));
+        }
+        catch (const std::exception &e)
+        {
+            LOG_ERROR << "CoroutineSession: Lane handler error: " << e.what() << std::endl;
+        }
+
+        // 出错的消息同样释放槽位与窗口
+        if (ordered)
+        {
+            EndOrdered(key);
+        }
+        ReleaseWindow();
+    }
+}
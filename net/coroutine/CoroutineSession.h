@@ -4,9 +4,15 @@
 
 #include <boost/asio/co_spawn.hpp>
 #include <boost/asio/detached.hpp>
-#include <boost/asio/steady_timer.hpp> // 使用定时器，实现 心跳检测定时器 和 快速心跳处理
+#include <boost/asio/steady_timer.hpp> // 使用定时器，实现窗口通知
 
 #include "../../core/session/CSession.h"
+#include "../../core/message/RecvBuffer.h"
+
+#include <deque>
+#include <unordered_map>
+
+class IService;
 
 namespace this_coro = boost::asio::this_coro;
 
@@ -19,13 +25,41 @@ public:
 
     ~CoroutineSession() override;
 
+    // 在途请求占满窗口或发送积压时读取暂停
+    bool IsReadPaused() const override { return this->_inflight >= this->_window || IsSendBlocked(); }
+
+protected:
+    // 发送积压回落，恢复读取
+    void OnSendResumed() override;
+    // 会话关闭，唤醒可能因窗口或发送积压而暂停的读循环，使其退出
+    void OnClosed() override;
+
 private:
-    // 启动心跳超时检查
-    void StartHeartbeatCheck();
+    // 分发一个完整的消息帧至对应服务
+    void DispatchMsg(std::shared_ptr<MsgNode> msg);
+    // 执行一个请求的业务回调，完成后释放槽位与窗口
+    boost::asio::awaitable<void> RunHandler(IService *service, std::shared_ptr<MsgNode> msg, bool ordered);
+    // 执行一个控制消息的业务回调（不占用窗口与顺序槽位，计入控制消息上限）
+    boost::asio::awaitable<void> RunControl(IService *service, std::shared_ptr<MsgNode> msg);
+    // 释放一个在途窗口，并唤醒读循环
+    void ReleaseWindow();
+    // 分发至按序处理的队列：流式命令按 (serviceId, cmdId, seq) 划分，串行服务按 SERIAL_LANE | serviceId 划分
+    void DispatchLane(IService *service, std::shared_ptr<MsgNode> msg, uint64_t lane);
+    // 按序处理某个队列中的消息，队列为空时结束
+    boost::asio::awaitable<void> DrainLane(IService *service, uint64_t lane);
+
+    // 串行服务队列的标识位（流式命令队列使用 MessageHeader::GetMessageKey，
+    // 已注册服务的 serviceId 小于 ServiceManager::MAX_SERVICE_ID，不会占用最高位）
+    static constexpr uint64_t SERIAL_LANE = 1ull << 63;
 
 private:
-    boost::asio::steady_timer _deadline;                      // 超时定时器
-    std::chrono::steady_clock::time_point _last_message_time; // 最后收到消息的时间
+    RecvBuffer _recvBuffer;                                   // 接收缓冲区，一次读取解析多帧
+    boost::asio::steady_timer _windowTimer;                   // 窗口通知定时器，请求完成或发送积压回落时取消以唤醒读循环
+    std::size_t _window;                                      // 在途请求窗口大小
+    std::size_t _inflight;                                    // 在途请求数（仅在 io_context 线程访问）
+    std::size_t _controlInflight;                             // 不占用窗口的在途控制消息数（仅在 io_context 线程访问）
+    std::unordered_map<uint64_t, std::deque<std::shared_ptr<MsgNode>>> _lanes; // 按序处理的队列 lane -> 消息队列
+    std::size_t _lanePendingBytes;                            // 队列中待处理消息的累计字节数
 };
 
 #endif
\ No newline at end of file
@@ -4,15 +4,28 @@
 #include "../../core/server/CServer.h"
 #include "../../core/logic/LogicNode.h"
 #include "../../core/logic/LogicSystem.h"
+#include "../../core/logic/DispatchScheduler.h"
 
 #include "../../infra/log/Logger.h"
+#include "../../config/ConfigManager.h"
+
+#include "../../services/IService.h"
+#include "../../services/ServiceManager.h"
 
 AsyncSession::AsyncSession(boost::asio::io_context &ioc, boost::asio::ip::tcp::socket socket, CServer *server)
-    : CSession(ioc, std::move(socket), server)
+    : CSession(ioc, std::move(socket), server),
+      _directDispatch(ConfigManager::GetInstance().IsAsyncDirectDispatch())
 {
 }
 
 void AsyncSession::Start()
+{
+    // 登记空闲检测
+    StartIdleCheck();
+    ReadHead();
+}
+
+void AsyncSession::ReadHead()
 {
     // 由于 CSession 继承于 std::enable_shared_from_this<CSession>
     // 导致 shared_from_this() 返回的是 CSession 的指针
@@ -37,18 +50,27 @@ void AsyncSession::HandleHeadRead(const boost::system::error_code &error, std::s
         {
             LOG_ERROR << "AsyncSession: Client Close a Connect." << std::endl;
             Close();
-            this->_server->DelSessionByUuid(this->_uuid);
+            this->_server->DelSessionById(this->_id);
         }
 
         if (bytes_transferred < MsgNode::GetHeaderSize())
         {
             LOG_ERROR << "AsyncSession: Received Head Error : Length Too Low" << std::endl;
             Close();
-            this->_server->DelSessionByUuid(this->_uuid);
+            this->_server->DelSessionById(this->_id);
         }
 
         // 转为本地主机字节序 必须转换！！！
         this->_recvNode->GetHeader().ToHost();
+
+        // 帧长度超过上限（可能是伪造的 Header），不再分配内存，直接断开
+        if (this->_recvNode->GetHeader().length > ConfigManager::GetInstance().GetMaxFrameSize())
+        {
+            LOG_WARN << "AsyncSession: Frame too large, close " << FormatSessionId(this->_id) << std::endl;
+            Close();
+            this->_server->DelSessionById(this->_id);
+            return;
+        }
         // 为消息节点分配内存
         this->_recvNode->Allocate(this->_recvNode->GetHeader().length);
 
@@ -66,7 +88,7 @@ void AsyncSession::HandleHeadRead(const boost::system::error_code &error, std::s
     {
         LOG_ERROR << "AsyncSession: Received Head Error occurred: " << error.message() << std::endl;
         Close();
-        this->_server->DelSessionByUuid(this->_uuid);
+        this->_server->DelSessionById(this->_id);
     }
 }
 
@@ -78,36 +100,176 @@ void AsyncSession::HandleMsgRead(const boost::system::error_code &error, std::si
         {
             LOG_ERROR << "AsyncSession: Received Msg Error : Length Too Low" << std::endl;
             Close();
-            this->_server->DelSessionByUuid(this->_uuid);
+            this->_server->DelSessionById(this->_id);
         }
 
-        // 打印消息内容
-        this->_recvNode->Print();
+        // 更新最后活动时间
+        TouchIdle();
 
-        LOG_INFO << "CoroutineSession: Recived Node to LogicSystem... " << std::endl;
         auto msg = std::move(_recvNode);
-        this->_recvNode = std::make_shared<MsgNode>();
+        this->_recvNode = MsgNode::Create();
 
-        LogicSystem::GetInstance().PostMsgToQue(std::make_shared<LogicNode>(shared_from_this(), msg));
+        // 预处理（解压等）与分片重组（流式命令除外，分片按序分发），
+        // 无效帧直接丢弃，分片未收齐时先缓存
+        if (PrepareInbound(msg) && (IsStreamMsg(*msg) || AssembleInbound(msg)))
+        {
+            // 打印消息内容
+            msg->Print();
 
-        // 继续读取头部信息
+            DispatchMsg(std::move(msg));
+        }
 
         // 清空消息节点
         this->_recvNode->Clear();
-        // 在调用 async_read 前进行转换
-        auto self = std::static_pointer_cast<AsyncSession>(shared_from_this());
 
-        boost::asio::async_read(this->_socket,
-                                boost::asio::buffer(this->_recvNode->GetHeaderData(), MsgNode::GetHeaderSize()),
-                                std::bind(&AsyncSession::HandleHeadRead,
-                                          self, // 使用已转换的派生类指针
-                                          std::placeholders::_1,
-                                          std::placeholders::_2));
+        // 发送积压超过高水位：暂停读取（TCP 背压），积压回落后由 OnSendResumed 恢复
+        if (IsSendBlocked())
+        {
+            this->_readPaused = true;
+            return;
+        }
+
+        // 继续读取头部信息
+        ReadHead();
     }
     else
     {
         LOG_ERROR << "AsyncSession: Received Msg Error occurred: " << error.message() << std::endl;
         Close();
-        this->_server->DelSessionByUuid(this->_uuid);
+        this->_server->DelSessionById(this->_id);
+    }
+}
+
+bool AsyncSession::IsStreamMsg(const MsgNode &msg) const
+{
+    auto service = ServiceManager::GetInstance().GetServiceById(msg.GetServiceId());
+    return service && service->IsStreamCmd(msg.GetCmdId());
+}
+
+void AsyncSession::DispatchMsg(std::shared_ptr<MsgNode> msg)
+{
+    auto service = ServiceManager::GetInstance().GetServiceById(msg->GetServiceId());
+    if (!service)
+    {
+        LOG_WARN << "No service for serviceId = " << msg->GetServiceId() << std::endl;
+        return;
+    }
+
+    // 非阻塞命令可以在本会话的 io_context 上执行（计算命令由 Handle 转至计算线程池执行）
+    auto cmdId = msg->GetCmdId();
+    bool onIoContext = !service->IsBlockingCmd(cmdId) || service->IsComputeCmd(cmdId);
+
+    // 流式命令的分片：无论哪种分发模式都按序逐个执行（每个分片单独启动协程时，回调挂起后顺序无法保证）
+    // 阻塞的流式命令交给 LogicSystem，同一会话固定在同一工作线程上逐个执行完毕，同样保持顺序
+    if (onIoContext && service->IsStreamCmd(cmdId))
+    {
+        DispatchLane(service, std::move(msg));
+        return;
+    }
+
+    // 直接执行：当前已在本会话的 io_context 线程，省去往返 LogicSystem 的两次线程切换
+    // 控制消息（如心跳）即使在 LogicSystem 分发模式下也直接执行，不排在普通消息之后
+    // 同时执行的控制消息超过 MAX_CONTROL_INFLIGHT 时，超出部分按普通消息分发
+    bool control = ConfigManager::GetInstance().GetPriority(msg->GetServiceId(), cmdId) == PRIORITY_CONTROL;
+    if (control && onIoContext && this->_controlInflight < MAX_CONTROL_INFLIGHT)
+    {
+        ++this->_controlInflight;
+        boost::asio::co_spawn(this->_ioc, RunControl(service, std::move(msg)), boost::asio::detached);
+        return;
+    }
+    if (this->_directDispatch && onIoContext)
+    {
+        boost::asio::co_spawn(this->_ioc, DispatchScheduler::Dispatch(service, shared_from_this(), std::move(msg)), boost::asio::detached);
+        return;
+    }
+
+    LOG_INFO << "AsyncSession: Recived Node to LogicSystem... " << std::endl;
+    LogicSystem::GetInstance().PostMsgToQue(std::make_shared<LogicNode>(shared_from_this(), std::move(msg)));
+}
+
+void AsyncSession::DispatchLane(IService *service, std::shared_ptr<MsgNode> msg)
+{
+    // 队列中未处理的消息同样计入接收预算，回调处理过慢时断开连接
+    this->_lanePendingBytes += msg->GetBodyLen();
+    if (this->_lanePendingBytes > ConfigManager::GetInstance().GetMaxMessageSize())
+    {
+        LOG_WARN << "AsyncSession: Lane backlog exceeds receive budget, close " << FormatSessionId(this->_id) << std::endl;
+        Close();
+        this->_server->DelSessionById(this->_id);
+        return;
+    }
+
+    auto lane = msg->GetHeader().GetMessageKey();
+    auto [it, created] = this->_lanes.try_emplace(lane);
+    it->second.push_back(std::move(msg));
+
+    // 已有协程在按序处理该队列
+    if (!created)
+        return;
+
+    boost::asio::co_spawn(this->_ioc,
+                          DrainLane(service, lane),
+                          boost::asio::detached);
+}
+
+boost::asio::awaitable<void> AsyncSession::DrainLane(IService *service, uint64_t lane)
+{
+    // 保持 Session 存活
+    auto self = shared_from_this();
+
+    // 读取回调与本协程运行在同一 io_context（单线程）上，访问 _lanes 无需加锁
+    for (;;)
+    {
+        auto it = this->_lanes.find(lane);
+        if (it == this->_lanes.end())
+            break;
+        // 队列已空，处理结束
+        if (it->second.empty())
+        {
+            this->_lanes.erase(it);
+            break;
+        }
+
+        auto msg = std::move(it->second.front());
+        it->second.pop_front();
+        this->_lanePendingBytes -= msg->GetBodyLen();
+
+        // 等待当前分片处理完成后再处理下一个，保证顺序
+        // 单个分片出错只记录日志，继续处理后续分片
+        try
+        {
+            co_await DispatchScheduler::Dispatch(service, self, std::move(msg));
+        }
+        catch (const std::exception &e)
+        {
+            LOG_ERROR << "AsyncSession: Lane handler error: " << e.what() << std::endl;
+        }
+    }
+}
+
+boost::asio::awaitable<void> AsyncSession::RunControl(IService *service, std::shared_ptr<MsgNode> msg)
+{
+    // 保持 Session 存活
+    auto self = shared_from_this();
+
+    try
+    {
+        co_await DispatchScheduler::Dispatch(service, self, std::move(msg));
+    }
+    catch (const std::exception &e)
+    {
+        LOG_ERROR << "AsyncSession: Control handler error: " << e.what() << std::endl;
+    }
+
+    --this->_controlInflight;
+}
+
+void AsyncSession::OnSendResumed()
+{
+    // 恢复因发送积压而暂停的读取
+    if (this->_readPaused && !this->_bStop)
+    {
+        this->_readPaused = false;
+        ReadHead();
     }
 }
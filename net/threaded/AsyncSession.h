@@ -6,17 +6,51 @@
 
 #include <boost/asio.hpp>
 
+#include <deque>
+#include <unordered_map>
+
+class IService;
+
 class AsyncSession : public CSession
 {
 public:
     AsyncSession(boost::asio::io_context &ioc, boost::asio::ip::tcp::socket socket, CServer *server);
     // 重写父类方法
     void Start() override;
+    // 发送积压时读取暂停
+    bool IsReadPaused() const override { return this->_readPaused; }
+
+protected:
+    // 发送积压回落，恢复读取
+    void OnSendResumed() override;
 
 private:
+    // 读取头部信息
+    void ReadHead();
     // 简易读取数据的方法 用于异步服务器实现
     void HandleHeadRead(const boost::system::error_code &error, std::size_t bytes_transferred);
     void HandleMsgRead(const boost::system::error_code &error, std::size_t bytes_transferred);
+    // 是否为流式命令的帧（不做重组）
+    bool IsStreamMsg(const MsgNode &msg) const;
+    // 分发一个完整的消息帧：直接分发模式下非阻塞命令在本会话的 io_context 上执行，其余交给 LogicSystem
+    void DispatchMsg(std::shared_ptr<MsgNode> msg);
+    // 流式命令的分片进入按 (serviceId, cmdId, seq) 划分的队列，按序逐个交给回调
+    void DispatchLane(IService *service, std::shared_ptr<MsgNode> msg);
+    // 按序处理某个队列中的消息，队列为空时结束
+    boost::asio::awaitable<void> DrainLane(IService *service, uint64_t lane);
+    // 执行一个控制消息的业务回调，结束后释放控制消息名额
+    boost::asio::awaitable<void> RunControl(IService *service, std::shared_ptr<MsgNode> msg);
+
+    // 是否因发送积压暂停了读取（仅在 io_context 线程访问）
+    bool _readPaused = false;
+    // 是否为直接分发模式
+    bool _directDispatch;
+    // 流式命令的按序队列 lane -> 消息队列（仅在 io_context 线程访问）
+    std::unordered_map<uint64_t, std::deque<std::shared_ptr<MsgNode>>> _lanes;
+    // 队列中待处理消息的累计字节数
+    std::size_t _lanePendingBytes = 0;
+    // 直接执行中的控制消息数（仅在 io_context 线程访问）
+    std::size_t _controlInflight = 0;
 };
 
 #endif // ASYNCSESSION_H
\ No newline at end of file
@@ -6,7 +6,7 @@ ClientManager &ClientManager::GetInstance()
     return instance;
 }
 
-bool ClientManager::AddClient(const std::string &key, const std::string &value)
+bool ClientManager::AddClient(const std::string &key, SessionId value)
 {
     // 加锁
     std::lock_guard<std::mutex> lock(this->_mutex);
@@ -37,7 +37,7 @@ bool ClientManager::RemoveClient(const std::string &key)
     return false;
 }
 
-std::string ClientManager::GetClient(const std::string &key)
+SessionId ClientManager::GetClient(const std::string &key)
 {
     // 加锁
     std::lock_guard<std::mutex> lock(this->_mutex);
@@ -47,8 +47,8 @@ std::string ClientManager::GetClient(const std::string &key)
         return this->_clientMap.at(key);
     }
 
-    // 默认返回空字符串
-    return std::string();
+    // 默认返回无效标识
+    return INVALID_SESSION_ID;
 }
 
 std::vector<std::string> ClientManager::GetAllClientName()
@@ -64,3 +64,18 @@ std::vector<std::string> ClientManager::GetAllClientName()
 
     return names;
 }
+
+std::vector<SessionId> ClientManager::GetAllClientId()
+{
+    // 加锁
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    std::vector<SessionId> ids;
+    ids.reserve(this->_clientMap.size());
+    for (auto &item : this->_clientMap)
+    {
+        ids.push_back(item.second);
+    }
+
+    return ids;
+}
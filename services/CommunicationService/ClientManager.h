@@ -7,6 +7,8 @@
 #include <mutex>
 #include <vector>
 
+#include "../../core/session/SessionId.h"
+
 // 客户端管理器，用于保存客户端的连接信息
 class ClientManager
 {
@@ -24,23 +26,26 @@ public:
     static ClientManager &GetInstance();
 
     // 添加客户端连接信息
-    bool AddClient(const std::string &key, const std::string &value);
+    bool AddClient(const std::string &key, SessionId value);
 
     // 删除客户端连接信息
     bool RemoveClient(const std::string &key);
 
-    // 获取客户端连接信息
-    std::string GetClient(const std::string &key);
+    // 获取客户端连接信息，不存在时返回 INVALID_SESSION_ID
+    SessionId GetClient(const std::string &key);
 
     // 获取所有客户端名称
     std::vector<std::string> GetAllClientName();
 
+    // 获取所有客户端的会话标识
+    std::vector<SessionId> GetAllClientId();
+
 private:
     ClientManager() = default;
     ~ClientManager() = default;
 
-    // 客户端连接信息 主键为
-    std::unordered_map<std::string, std::string> _clientMap;
+    // 客户端连接信息 主键为客户端名称，值为会话标识
+    std::unordered_map<std::string, SessionId> _clientMap;
     // 互斥锁
     std::mutex _mutex;
 };
@@ -5,6 +5,7 @@
 
 #include "../../infra/log/Logger.h"
 #include "../../core/protocol/JsonResponse.h"
+#include "../../core/protocol/BodyCodec.h"
 
 #include <memory>
 
@@ -19,10 +20,12 @@ uint16_t CommunicationService::GetServiceId() const
 
 void CommunicationService::RegisterCmd()
 {
-    this->_cmdMap[COMMUINICATION_REGISTER] = std::bind(&CommunicationService::OnCreateCallBack, this, std::placeholders::_1, std::placeholders::_2);
-    this->_cmdMap[COMMUINICATION_CLOSE] = std::bind(&CommunicationService::OnCloseCallBack, this, std::placeholders::_1, std::placeholders::_2);
-    this->_cmdMap[COMMUINICATION_SEND] = std::bind(&CommunicationService::OnSendCallBack, this, std::placeholders::_1, std::placeholders::_2);
-    this->_cmdMap[COMMUINICATION_SHOW] = std::bind(&CommunicationService::OnShowCallBack, this, std::placeholders::_1, std::placeholders::_2);
+    RegisterCmdHandler<&CommunicationService::OnCreateCallBack>(COMMUINICATION_REGISTER);
+    RegisterCmdHandler<&CommunicationService::OnCloseCallBack>(COMMUINICATION_CLOSE);
+    RegisterCmdHandler<&CommunicationService::OnSendCallBack>(COMMUINICATION_SEND);
+    RegisterCmdHandler<&CommunicationService::OnShowCallBack>(COMMUINICATION_SHOW);
+    RegisterCmdHandler<&CommunicationService::OnBroadcastCallBack>(COMMUINICATION_BROADCAST);
+    RegisterCmdHandler<&CommunicationService::OnUploadCallBack>(COMMUINICATION_UPLOAD, CMD_FLAG_STREAM);
 }
 
 boost::asio::awaitable<void> CommunicationService::OnCreateCallBack(std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg)
@@ -43,8 +46,7 @@ boost::asio::awaitable<void> CommunicationService::OnCreateCallBack(std::shared_
         // 获取端口号
         auto port = endpoint.port();
 
-        auto reqJson = nlohmann::json::parse(
-            std::string(msg->GetBody(), msg->GetBodyLen()));
+        auto reqJson = BodyCodec::Decode(*msg);
 
         // 获取 target 信息 其包含了客户端的信息
         auto &target = reqJson.at("target");
@@ -56,9 +58,10 @@ boost::asio::awaitable<void> CommunicationService::OnCreateCallBack(std::shared_
 
         // 将 clientInfo 保存到 session 中
         session->SetClientInfo(clientInfo);
+        session->SetClientName(name);
 
         // 添加至客户端管理器
-        auto success = ClientManager::GetInstance().AddClient(name, session->GetUuid());
+        auto success = ClientManager::GetInstance().AddClient(name, session->GetId());
 
         nlohmann::json resp;
         if (success)
@@ -107,8 +110,7 @@ boost::asio::awaitable<void> CommunicationService::OnCloseCallBack(std::shared_p
     try
     {
         // 获取 target 信息 其包含了客户端的信息
-        auto reqJson = nlohmann::json::parse(
-            std::string(msg->GetBody(), msg->GetBodyLen()));
+        auto reqJson = BodyCodec::Decode(*msg);
 
         auto &target = reqJson.at("target");
         // 获取客户端指定的名称
@@ -166,8 +168,7 @@ boost::asio::awaitable<void> CommunicationService::OnSendCallBack(std::shared_pt
     try
     {
         // 获取 target 信息 其包含了客户端的信息
-        auto reqJson = nlohmann::json::parse(
-            std::string(msg->GetBody(), msg->GetBodyLen()));
+        auto reqJson = BodyCodec::Decode(*msg);
 
         auto &target = reqJson.at("target");
         // // 获取发送方的名称
@@ -183,10 +184,10 @@ boost::asio::awaitable<void> CommunicationService::OnSendCallBack(std::shared_pt
         // 获取消息内容
         auto message = target.at("message").get<std::string>();
 
-        // 获取接收端的 session 的 uuid
-        auto clientSessionUuid = ClientManager::GetInstance().GetClient(clientName);
+        // 获取接收端的 session 的标识
+        auto clientSessionId = ClientManager::GetInstance().GetClient(clientName);
         // 未找到接收端
-        if (clientSessionUuid.empty())
+        if (clientSessionId == INVALID_SESSION_ID)
         {
             // 声明错误信息
             std::string errorMsg = "client name not exists";
@@ -211,7 +212,7 @@ boost::asio::awaitable<void> CommunicationService::OnSendCallBack(std::shared_pt
         forwardHdr.seq = 0;                     // 推送消息通常不需要复用发送者的 seq，置 0 即可
 
         // 发送信息
-        auto success = session->SendToOtherSession(clientSessionUuid, forwardHdr, mJson.dump());
+        auto success = session->SendToOtherSession(clientSessionId, forwardHdr, mJson);
 
         if (success)
         {
@@ -292,3 +293,149 @@ boost::asio::awaitable<void> CommunicationService::OnShowCallBack(std::shared_pt
 
     co_return;
 }
+
+boost::asio::awaitable<void> CommunicationService::OnBroadcastCallBack(std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg)
+{
+    LOG_INFO << "CommunicationService OnBroadcastCallBack" << "\n";
+
+    // 获取请求头
+    auto &hdr = msg->GetHeader();
+
+    try
+    {
+        auto reqJson = BodyCodec::Decode(*msg);
+
+        // 获取消息内容
+        auto &target = reqJson.at("target");
+        auto message = target.at("message").get<std::string>();
+
+        // 避免发送方伪造名称
+        std::string name = "Unknown";
+        if (auto info = session->GetClientInfo())
+        {
+            name = info->GetName();
+        }
+
+        // 组装 JSON 信息
+        nlohmann::json mJson = {
+            {"from", name},
+            {"message", message}};
+
+        MessageHeader forwardHdr = hdr;
+        forwardHdr.cmdId = COMMUINICATION_RECV;
+        forwardHdr.seq = 0;
+
+        // 所有已注册的客户端（同一编码方式的接收方共享同一帧，不逐个拷贝）
+        auto ids = ClientManager::GetInstance().GetAllClientId();
+        auto count = session->BroadcastToSessions(ids, forwardHdr, mJson);
+
+        nlohmann::json data;
+        data["count"] = count;
+
+        auto resp = JsonResponse::Ok(
+            hdr.serviceId, hdr.cmdId, hdr.seq,
+            {{"result", data}});
+
+        // 回传结果
+        session->Send(hdr, resp);
+    }
+    catch (const std::exception &e)
+    {
+        // 声明错误信息
+        std::string errorMsg = "invalid request json";
+
+        auto resp = JsonResponse::Error(
+            hdr.serviceId, hdr.cmdId, hdr.seq,
+            29999, errorMsg);
+
+        // 回传结果
+        session->Send(hdr, resp);
+
+        LOG_ERROR << e.what() << '\n';
+    }
+
+    co_return;
+}
+
+boost::asio::awaitable<void> CommunicationService::OnUploadCallBack(std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg)
+{
+    // 获取请求头
+    auto &hdr = msg->GetHeader();
+    // 是否还有后续分片
+    bool more = hdr.HasFlag(HEADER_FLAG_MORE);
+
+    // 回应不带分片标志
+    MessageHeader respHdr = hdr;
+    respHdr.SetFlag(HEADER_FLAG_MORE, false);
+
+    try
+    {
+        // 每个分片都是独立的请求体：{"target": {"client": 接收方, "data": 本片内容}}
+        auto reqJson = BodyCodec::Decode(*msg);
+
+        auto &target = reqJson.at("target");
+        auto clientName = target.at("client").get<std::string>();
+        auto data = target.at("data").get<std::string>();
+
+        // 避免发送方伪造名称
+        std::string name = "Unknown";
+        if (auto info = session->GetClientInfo())
+        {
+            name = info->GetName();
+        }
+
+        // 获取接收端的 session 的标识
+        auto clientSessionId = ClientManager::GetInstance().GetClient(clientName);
+
+        // 组装 JSON 信息：分片收到即转发，接收方按 more 判断是否结束
+        nlohmann::json mJson = {
+            {"from", name},
+            {"seq", hdr.seq},
+            {"data", data},
+            {"more", more}};
+
+        // 转发帧为独立的完整消息（不带分片标志），接收方无需重组
+        MessageHeader forwardHdr = respHdr;
+        forwardHdr.seq = 0;
+
+        if (clientSessionId == INVALID_SESSION_ID || !session->SendToOtherSession(clientSessionId, forwardHdr, mJson))
+        {
+            // 声明错误信息
+            std::string errorMsg = "client name or session not exists";
+
+            auto resp = JsonResponse::Error(
+                respHdr.serviceId, respHdr.cmdId, respHdr.seq,
+                20003, errorMsg);
+
+            // 回传结果
+            session->Send(respHdr, resp);
+            co_return;
+        }
+
+        // 最后一个分片转发完成后回应
+        if (!more)
+        {
+            auto resp = JsonResponse::Ok(
+                respHdr.serviceId, respHdr.cmdId, respHdr.seq);
+
+            // 回传结果
+            session->Send(respHdr, resp);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        // 声明错误信息
+        std::string errorMsg = "invalid request json";
+
+        auto resp = JsonResponse::Error(
+            respHdr.serviceId, respHdr.cmdId, respHdr.seq,
+            29999, errorMsg);
+
+        // 回传结果
+        session->Send(respHdr, resp);
+
+        LOG_ERROR << e.what() << '\n';
+    }
+
+    co_return;
+}
@@ -22,6 +22,10 @@ private:
     boost::asio::awaitable<void> OnSendCallBack(std::shared_ptr<CSession>, std::shared_ptr<MsgNode>);
     // 显示信息回调方法
     boost::asio::awaitable<void> OnShowCallBack(std::shared_ptr<CSession>, std::shared_ptr<MsgNode>);
+    // 广播消息回调方法
+    boost::asio::awaitable<void> OnBroadcastCallBack(std::shared_ptr<CSession>, std::shared_ptr<MsgNode>);
+    // 流式转发回调方法（流式命令，同一 seq 的分片按序逐个到达）
+    boost::asio::awaitable<void> OnUploadCallBack(std::shared_ptr<CSession>, std::shared_ptr<MsgNode>);
 };
 
 #endif // COMMUNICATIONSERVICE_H
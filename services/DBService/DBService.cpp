@@ -5,6 +5,7 @@
 
 #include "../../infra/log/Logger.h"
 #include "../../core/protocol/JsonResponse.h"
+#include "../../core/protocol/BodyCodec.h"
 
 DBService::DBService()
 {
@@ -19,10 +20,9 @@ uint16_t DBService::GetServiceId() const
 
 void DBService::RegisterCmd()
 {
-    this->_cmdMap[DB_EXECUTE] = std::bind(&DBService::OnExecuteCallBack, this,
-                                          std::placeholders::_1, std::placeholders::_2);
-    this->_cmdMap[DB_CLOSE] = std::bind(&DBService::OnCloseCallBack, this,
-                                        std::placeholders::_1, std::placeholders::_2);
+    // SQLite 为同步调用、结果集转换为 JSON 耗时较长，在计算线程池中执行（已不占用网络线程，无需再声明为阻塞命令）
+    RegisterCmdHandler<&DBService::OnExecuteCallBack>(DB_EXECUTE, CMD_FLAG_COMPUTE);
+    RegisterCmdHandler<&DBService::OnCloseCallBack>(DB_CLOSE, CMD_FLAG_COMPUTE);
 }
 
 boost::asio::awaitable<void> DBService::OnExecuteCallBack(std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg)
@@ -54,8 +54,7 @@ boost::asio::awaitable<void> DBService::OnCloseCallBack(std::shared_ptr<CSession
 
 DBRequest DBService::ParseRequest(std::shared_ptr<MsgNode> msg)
 {
-    auto reqJson = nlohmann::json::parse(
-        std::string(msg->GetBody(), msg->GetBodyLen()));
+    auto reqJson = BodyCodec::Decode(*msg);
 
     DBRequest req;
 
@@ -17,7 +17,7 @@ uint16_t HeartService::GetServiceId() const
 
 void HeartService::RegisterCmd()
 {
-    this->_cmdMap[HEART_RECV] = std::bind(&HeartService::OnRecvHeartCallBack, this, std::placeholders::_1, std::placeholders::_2);
+    RegisterCmdHandler<&HeartService::OnRecvHeartCallBack>(HEART_RECV);
 }
 
 boost::asio::awaitable<void> HeartService::OnRecvHeartCallBack(std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg)
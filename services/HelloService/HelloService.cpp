@@ -16,8 +16,7 @@ uint16_t HelloService::GetServiceId() const
 
 void HelloService::RegisterCmd()
 {
-    this->_cmdMap[HELLO_CMD_TEST] = std::bind(&HelloService::OnHelloCallBack, this,
-                                              std::placeholders::_1, std::placeholders::_2);
+    RegisterCmdHandler<&HelloService::OnHelloCallBack>(HELLO_CMD_TEST);
 }
 
 boost::asio::awaitable<void> HelloService::OnHelloCallBack(std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg)
@@ -37,6 +36,6 @@ boost::asio::awaitable<void> HelloService::OnHelloCallBack(std::shared_ptr<CSess
     rsp.seq = msg->GetHeader().seq;
 
     // 执行回调
-    session->Send(rsp, text);
+    session->Send(rsp, std::move(text));
     co_return;
 }
@@ -1,29 +1,52 @@
-
 #include "IService.h"
 
 #include "../infra/log/Logger.h"
+#include "../core/logic/ComputePool.h"
+
+// 未注册的命令
+static boost::asio::awaitable<void> CmdNotFound(uint16_t serviceId, uint16_t cmdId)
+{
+    LOG_WARN << "Service " << serviceId << ": Not found cmdId " << cmdId << std::endl;
+    co_return;
+}
+
+// 在计算线程池中执行回调，当前协程等待其完成
+static boost::asio::awaitable<void> RunOnComputePool(IService::CmdThunk thunk, IService *service, std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg)
+{
+    co_await Offload([thunk, service, session = std::move(session), msg = std::move(msg)]() mutable
+                     { ComputePool::RunToCompletion(thunk(service, std::move(session), std::move(msg))); });
+}
 
 // 分发 cmd
 boost::asio::awaitable<void> IService::Handle(std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg)
 {
-    // 获取头部信息
-    auto &header = msg->GetHeader();
-
     // 获取命令 ID
-    auto cmdId = header.cmdId;
+    auto cmdId = msg->GetCmdId();
 
-    // 尝试获取命令回调
-    auto it = this->_cmdMap.find(cmdId);
-    if (it != this->_cmdMap.end())
+    // 直接下标查找命令表
+    auto entry = FindCmd(cmdId);
+    if (entry == nullptr)
     {
-        // 执行回调
-        co_await it->second(session, msg);
+        return CmdNotFound(GetServiceId(), cmdId);
     }
-    // 没有找到回调
-    else
+
+    // 计算命令：不占用网络线程
+    if (entry->flags & CMD_FLAG_COMPUTE)
     {
-        LOG_WARN << "HelloService: Not found cmdId " << cmdId << std::endl;
+        return RunOnComputePool(entry->thunk, this, std::move(session), std::move(msg));
     }
 
-    co_return;
-}
\ No newline at end of file
+    // 执行回调
+    return entry->thunk(this, std::move(session), std::move(msg));
+}
+
+std::size_t IService::GetCmdCount() const
+{
+    std::size_t count = 0;
+    for (auto &entry : this->_cmds)
+    {
+        if (entry.thunk != nullptr)
+            ++count;
+    }
+    return count;
+}
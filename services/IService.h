@@ -1,12 +1,11 @@
-
-
 #ifndef SERVICES_ISERVICE_H
 #define SERVICES_ISERVICE_H
 
 #include <memory>
 #include <cstdint>
-#include <functional>
-#include <unordered_map>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <boost/asio.hpp>
 
@@ -15,11 +14,27 @@
 #include "../core/common/Const.h"
 #include "../core/session/CSession.h"
 
+// 命令标志
+constexpr uint8_t CMD_FLAG_NONE = 0x00;
+constexpr uint8_t CMD_FLAG_STREAM = 0x01; // 流式命令：分片不重组，逐个按序交给回调
+constexpr uint8_t CMD_FLAG_BLOCKING = 0x02; // 阻塞命令：回调中有同步阻塞调用，AsyncSession 直接分发模式下仍交给 LogicSystem 线程执行
+constexpr uint8_t CMD_FLAG_COMPUTE = 0x04;  // 计算命令：整个回调在计算线程池中执行，完成后回到原协程（优先于阻塞标志）
+
 class IService
 {
 public:
-    // 回调函数模版
-    typedef std::function<boost::asio::awaitable<void>(std::shared_ptr<CSession>, std::shared_ptr<MsgNode> msg)> CmdFunCallBack;
+    // 命令回调：普通函数指针，由模板 thunk 直接转发至子类成员函数（无 std::function 类型擦除与 bind 开销）
+    typedef boost::asio::awaitable<void> (*CmdThunk)(IService *, std::shared_ptr<CSession>, std::shared_ptr<MsgNode>);
+
+    // 命令表项
+    struct CmdEntry
+    {
+        CmdThunk thunk = nullptr;
+        uint8_t flags = CMD_FLAG_NONE;
+    };
+
+    // 命令 ID 上限（命令表按 cmdId 直接下标访问）
+    static constexpr uint16_t MAX_CMD_ID = 1024;
 
     virtual ~IService() = default;
 
@@ -29,12 +44,82 @@ public:
     // 纯虚函数 注册 cmd
     virtual void RegisterCmd() = 0;
 
-    // 子类公用方法 分发 cmd
+    // 子类公用方法 分发 cmd（直接返回回调的 awaitable，不额外创建协程帧；计算命令包装为在计算线程池中执行）
     boost::asio::awaitable<void> Handle(std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg);
 
+    // 查找命令表项，未注册时返回 nullptr（命令表在启动完成后只读，无需加锁）
+    const CmdEntry *FindCmd(uint16_t cmdId) const
+    {
+        if (cmdId >= this->_cmds.size() || this->_cmds[cmdId].thunk == nullptr)
+            return nullptr;
+        return &this->_cmds[cmdId];
+    }
+
+    // 是否为流式命令：分片逐个按序交给回调（回调通过 HEADER_FLAG_MORE 判断是否还有后续分片），
+    // 否则由会话重组为完整消息后再分发
+    bool IsStreamCmd(uint16_t cmdId) const
+    {
+        auto entry = FindCmd(cmdId);
+        return entry && (entry->flags & CMD_FLAG_STREAM) != 0;
+    }
+
+    // 是否为阻塞命令
+    bool IsBlockingCmd(uint16_t cmdId) const
+    {
+        auto entry = FindCmd(cmdId);
+        return entry && (entry->flags & CMD_FLAG_BLOCKING) != 0;
+    }
+
+    // 是否为计算命令
+    bool IsComputeCmd(uint16_t cmdId) const
+    {
+        auto entry = FindCmd(cmdId);
+        return entry && (entry->flags & CMD_FLAG_COMPUTE) != 0;
+    }
+
+    // 获取已注册的命令数量
+    std::size_t GetCmdCount() const;
+
 protected:
-    // 命令回调字典 子类使用
-    std::unordered_map<uint16_t, CmdFunCallBack> _cmdMap;
+    // 注册命令回调 子类在 RegisterCmd 中使用，如：
+    // RegisterCmdHandler<&HelloService::OnHelloCallBack>(HELLO_CMD_TEST);
+    // cmdId 越界或重复注册时抛出异常，在启动阶段暴露配置错误
+    template <auto Method>
+    void RegisterCmdHandler(uint16_t cmdId, uint8_t flags = CMD_FLAG_NONE)
+    {
+        if (cmdId >= MAX_CMD_ID)
+            throw std::out_of_range("cmdId " + std::to_string(cmdId) + " out of range");
+
+        if (cmdId >= this->_cmds.size())
+            this->_cmds.resize(cmdId + 1);
+
+        if (this->_cmds[cmdId].thunk != nullptr)
+            throw std::logic_error("cmdId " + std::to_string(cmdId) + " already registered");
+
+        this->_cmds[cmdId].thunk = &CmdThunkOf<Method>;
+        this->_cmds[cmdId].flags = flags;
+    }
+
+private:
+    // 成员函数指针所属的类
+    template <typename>
+    struct MemberOf;
+    template <typename C, typename R, typename... Args>
+    struct MemberOf<R (C::*)(Args...)>
+    {
+        using type = C;
+    };
+
+    // 转发至子类成员函数
+    template <auto Method>
+    static boost::asio::awaitable<void> CmdThunkOf(IService *service, std::shared_ptr<CSession> session, std::shared_ptr<MsgNode> msg)
+    {
+        using Service = typename MemberOf<decltype(Method)>::type;
+        return (static_cast<Service *>(service)->*Method)(std::move(session), std::move(msg));
+    }
+
+    // 命令表 下标为 cmdId
+    std::vector<CmdEntry> _cmds;
 };
 
-#endif // SERVICES_ISERVICE_H
\ No newline at end of file
+#endif // SERVICES_ISERVICE_H
@@ -23,36 +23,69 @@ void ServiceManager::RegisterService(std::shared_ptr<IService> service)
 
     // 加锁
     std::lock_guard<std::mutex> lock(this->_mutex);
+
+    // 冻结后不允许再注册（查找不加锁）
+    if (this->_frozen)
+    {
+        LOG_ERROR << "ServiceManager is frozen, reject service " << service->GetServiceId() << std::endl;
+        return;
+    }
+
     // 获取 serviceId
     auto serviceId = service->GetServiceId();
+    if (serviceId >= MAX_SERVICE_ID)
+    {
+        LOG_ERROR << "Service " << serviceId << " out of range " << std::endl;
+        return;
+    }
     // 检查服务是否已经存在
-    if (this->_serviceMap.count(serviceId) > 0)
+    if (serviceId < this->_services.size() && this->_services[serviceId] != nullptr)
     {
         LOG_WARN << "Service " << serviceId << " already registered " << std::endl;
         return;
     }
-    // 对服务的命令进行注册
-    service->RegisterCmd();
+    // 对服务的命令进行注册（cmdId 越界或重复时抛出异常）
+    // 注册通常发生在静态初始化阶段，异常不能向外传播（否则在 main 之前直接终止且没有日志），记录后拒绝该服务
+    try
+    {
+        service->RegisterCmd();
+    }
+    catch (const std::exception &e)
+    {
+        LOG_ERROR << "Service " << serviceId << " register command failed, reject it: " << e.what() << std::endl;
+        return;
+    }
     // 注册服务
-    this->_serviceMap[serviceId] = service;
+    if (serviceId >= this->_services.size())
+    {
+        this->_services.resize(serviceId + 1);
+    }
+    this->_services[serviceId] = std::move(service);
 }
 
-std::shared_ptr<IService> ServiceManager::GetServiceById(const uint16_t serviceId)
+void ServiceManager::Freeze()
 {
     // 加锁
     std::lock_guard<std::mutex> lock(this->_mutex);
-    
-    auto iter = this->_serviceMap.find(serviceId);
-    if (iter != this->_serviceMap.end())
+
+    for (auto &service : this->_services)
     {
-        return iter->second;
+        if (service == nullptr)
+            continue;
+
+        // 没有任何命令的服务视为注册错误
+        auto cmdCount = service->GetCmdCount();
+        if (cmdCount == 0)
+        {
+            LOG_WARN << "Service " << service->GetServiceId() << " has no command registered" << std::endl;
+        }
+        LOG_INFO << "Service " << service->GetServiceId() << " registered with " << cmdCount << " commands" << std::endl;
     }
 
-    LOG_WARN << "Service " << serviceId << " Not found " << std::endl;
-    return nullptr;
+    this->_frozen = true;
 }
 
 void ServiceManager::ClearService()
 {
-    this->_serviceMap.clear();
+    this->_services.clear();
 }
@@ -1,16 +1,22 @@
-
 #ifndef SERVICE_MANAGER_H
 #define SERVICE_MANAGER_H
 
 #include "IService.h"
 
+#include <atomic>
 #include <mutex>
+#include <vector>
 
+// 服务管理器
+// 启动阶段注册服务（加锁），Freeze 之后服务表只读，按 serviceId 直接下标查找，不再加锁
 class ServiceManager
 {
 private:
     /* data */
 public:
+    // serviceId 上限（服务表按 serviceId 直接下标访问）
+    static constexpr uint16_t MAX_SERVICE_ID = 256;
+
     // 删除拷贝构造函数
     ServiceManager(const ServiceManager &) = delete;
     // 删除赋值构造函数
@@ -22,17 +28,28 @@ public:
     // 静态方法 获取单例
     static ServiceManager &GetInstance();
 
-    // 注册服务
+    // 注册服务（仅在 Freeze 之前有效，命令注册失败的服务被拒绝）
     void RegisterService(std::shared_ptr<IService> service);
-    // 获取服务
-    std::shared_ptr<IService> GetServiceById(const uint16_t serviceId);
+    // 冻结服务表：校验注册结果并输出，此后不再允许注册，查找无需加锁
+    // 必须在 IO 线程启动（开始接收连接）之前调用
+    void Freeze();
+    // 获取服务，不存在时返回 nullptr（服务由管理器持有，直至程序退出）
+    IService *GetServiceById(const uint16_t serviceId) const
+    {
+        if (serviceId >= this->_services.size())
+            return nullptr;
+        return this->_services[serviceId].get();
+    }
     // 清空服务
     void ClearService();
 
 private:
     ServiceManager() = default;
-    std::unordered_map<uint16_t, std::shared_ptr<IService>> _serviceMap;
-    // 线程安全锁
+    // 服务表 下标为 serviceId
+    std::vector<std::shared_ptr<IService>> _services;
+    // 是否已冻结
+    std::atomic<bool> _frozen{false};
+    // 线程安全锁（仅注册阶段使用）
     std::mutex _mutex;
 };
 